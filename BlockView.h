@@ -0,0 +1,291 @@
+#ifndef _MATRIX_BLOCKVIEW_H
+#define _MATRIX_BLOCKVIEW_H
+
+#include <null_t.h>
+#include <GenericExpression.h>
+#include <GenericMatrix.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class ConstBlockView
+  \brief Шаблон ConstBlockView - блок матрицы только для чтения, без копирования элементов
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк блока
+  \tparam m - количество столбцов блока
+
+  Блок задается указателем на левый верхний элемент и шагом строк исходной матрицы и является выражением \a n x \a m.
+  Произведения блоков вычисляются ядрами умножения с шагом строк, без копирования множителей.
+*/
+template<typename T, int n, int m>
+class ConstBlockView : public GenericExpression<ConstBlockView<T, n, m>, T, n, m> {
+    const T* m_array;
+    int m_stride;
+public:
+/*! \typedef ElementType
+  тип элементов матрицы
+*/
+    typedef T ElementType;
+
+/*!
+  количество строк блока
+*/
+    static const int rows = n;
+
+/*!
+  количество столбцов блока
+*/
+    static const int columns = m;
+
+/*!
+  \param array - указатель на левый верхний элемент блока
+  \param stride - шаг строк исходной матрицы
+*/
+    MATRIX_CONSTEXPR ConstBlockView (const T* array, int stride) : m_array(array), m_stride(stride) {
+    }
+
+/*!
+  оператор индексации
+  \param row - индекс строки блока
+  \return константный указатель на строку блока
+*/
+    MATRIX_CONSTEXPR const T* operator [] (int row) const {
+        return m_array + row * m_stride;
+    }
+
+    MATRIX_CONSTEXPR T item (int index) const {
+        return m_array[index / m * m_stride + index % m];
+    }
+
+/*!
+  константный указатель на левый верхний элемент блока
+*/
+    MATRIX_CONSTEXPR const T* array (void) const {
+        return m_array;
+    }
+
+/*!
+  шаг строк исходной матрицы
+*/
+    MATRIX_CONSTEXPR int stride (void) const {
+        return m_stride;
+    }
+};
+
+/*! \class BlockView
+  \brief Шаблон BlockView - изменяемый блок матрицы без копирования элементов
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк блока
+  \tparam m - количество столбцов блока
+
+  Присваивание и арифметика изменяют элементы исходной матрицы; выражение в правой части
+  не должно читать перекрывающиеся с блоком элементы.
+*/
+template<typename T, int n, int m>
+class BlockView : public ConstBlockView<T, n, m> {
+public:
+/*!
+  \param array - указатель на левый верхний элемент блока
+  \param stride - шаг строк исходной матрицы
+*/
+    MATRIX_CONSTEXPR BlockView (T* array, int stride) : ConstBlockView<T, n, m>(array, stride) {
+    }
+
+    MATRIX_CONSTEXPR BlockView (const BlockView& other) : ConstBlockView<T, n, m>(other) {
+    }
+
+/*!
+  оператор копирования элементов другого блока (построчно)
+  \param other - копируемый блок
+*/
+    MATRIX_CONSTEXPR BlockView& operator = (const ConstBlockView<T, n, m>& other) {
+        for (int i = 0; i < n; ++i) {
+            algorithms::cp((*this)[i], other[i], m);
+        }
+        return *this;
+    }
+
+    MATRIX_CONSTEXPR BlockView& operator = (const BlockView& other) {
+        return *this = static_cast<const ConstBlockView<T, n, m>&>(other);
+    }
+
+/*!
+  оператор присваивания отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR BlockView& operator = (const GenericExpression<E, T, n, m>& expression) {
+        algorithms::eval(array(), this->stride(), expression.expression(), n, m);
+        return *this;
+    }
+
+/*!
+  оператор обнуления блока
+*/
+    MATRIX_CONSTEXPR BlockView& operator = (null_t) {
+        for (int i = 0; i < n; ++i) {
+            algorithms::null((*this)[i], 1, m);
+        }
+        return *this;
+    }
+
+/*!
+  оператор умножения на скаляр
+  \param scalar - скалярный множитель
+*/
+    MATRIX_CONSTEXPR BlockView& operator *= (const T& scalar) {
+        for (int i = 0; i < n; ++i) {
+            algorithms::mul((*this)[i], scalar, 1, m);
+        }
+        return *this;
+    }
+
+/*!
+  оператор прибавления отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR BlockView& operator += (const GenericExpression<E, T, n, m>& expression) {
+        algorithms::eval_add(array(), this->stride(), expression.expression(), n, m);
+        return *this;
+    }
+
+/*!
+  оператор вычитания отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR BlockView& operator -= (const GenericExpression<E, T, n, m>& expression) {
+        algorithms::eval_sub(array(), this->stride(), expression.expression(), n, m);
+        return *this;
+    }
+
+/*!
+  оператор индексации
+  \param row - индекс строки блока
+  \return указатель на строку блока
+*/
+    MATRIX_CONSTEXPR T* operator [] (int row) const {
+        return array() + row * this->stride();
+    }
+
+/*!
+  указатель на левый верхний элемент блока
+*/
+    MATRIX_CONSTEXPR T* array (void) const {
+        return const_cast<T*>(ConstBlockView<T, n, m>::array());
+    }
+};
+
+/*! \relates BlockView
+  блок матрицы
+  \tparam n1 - количество строк блока
+  \tparam m1 - количество столбцов блока
+  \param M - матрица \a n x \a m
+  \param i0 - индекс первой строки блока
+  \param j0 - индекс первого столбца блока
+  \return изменяемый блок \a n1 x \a m1 матрицы \a M
+*/
+template<int n1, int m1, typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR BlockView<T, n1, m1> block (GenericMatrix<T, n, m, S>& M, int i0, int j0) {
+    return BlockView<T, n1, m1>(M.array() + i0 * m + j0, m);
+}
+
+/*! \relates ConstBlockView
+  блок матрицы только для чтения
+  \tparam n1 - количество строк блока
+  \tparam m1 - количество столбцов блока
+  \param M - матрица \a n x \a m
+  \param i0 - индекс первой строки блока
+  \param j0 - индекс первого столбца блока
+  \return блок \a n1 x \a m1 матрицы \a M
+*/
+template<int n1, int m1, typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR ConstBlockView<T, n1, m1> block (const GenericMatrix<T, n, m, S>& M, int i0, int j0) {
+    return ConstBlockView<T, n1, m1>(M.array() + i0 * m + j0, m);
+}
+
+/*! \relates BlockView
+  блок блока матрицы
+  \tparam n1 - количество строк блока
+  \tparam m1 - количество столбцов блока
+  \param B - блок \a n x \a m
+  \param i0 - индекс первой строки блока в \a B
+  \param j0 - индекс первого столбца блока в \a B
+  \return изменяемый блок \a n1 x \a m1 исходной матрицы
+*/
+template<int n1, int m1, typename T, int n, int m>
+MATRIX_CONSTEXPR BlockView<T, n1, m1> block (const BlockView<T, n, m>& B, int i0, int j0) {
+    return BlockView<T, n1, m1>(B[i0] + j0, B.stride());
+}
+
+/*! \relates ConstBlockView
+  блок блока матрицы только для чтения
+  \tparam n1 - количество строк блока
+  \tparam m1 - количество столбцов блока
+  \param B - блок \a n x \a m
+  \param i0 - индекс первой строки блока в \a B
+  \param j0 - индекс первого столбца блока в \a B
+  \return блок \a n1 x \a m1 исходной матрицы
+*/
+template<int n1, int m1, typename T, int n, int m>
+MATRIX_CONSTEXPR ConstBlockView<T, n1, m1> block (const ConstBlockView<T, n, m>& B, int i0, int j0) {
+    return ConstBlockView<T, n1, m1>(B[i0] + j0, B.stride());
+}
+
+/*! \relates ConstBlockView
+  произведение блоков матриц
+  \tparam n - количество строк первого множителя
+  \tparam k - количество столбцов первого множителя, равное количеству строк второго множителя
+  \tparam m - количество столбцов второго множителя
+  \param lhs - блок \a n x \a k
+  \param rhs - блок \a k x \a m
+  \return произведение \a lhs и \a rhs, матрица \a n x \a m
+*/
+template<typename T, int n, int k, int m>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const ConstBlockView<T, n, k>& lhs, const ConstBlockView<T, k, m>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::mul(R.array(), m, lhs.array(), lhs.stride(), rhs.array(), rhs.stride(), n, k, m);
+    return R;
+}
+
+/*! \relates ConstBlockView
+  произведение блока матрицы на матрицу
+  \param lhs - блок \a n x \a k
+  \param rhs - матрица \a k x \a m
+  \return произведение \a lhs и \a rhs, матрица \a n x \a m
+*/
+template<typename T, int n, int k, int m, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const ConstBlockView<T, n, k>& lhs, const GenericMatrix<T, k, m, S>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::mul(R.array(), m, lhs.array(), lhs.stride(), rhs.array(), m, n, k, m);
+    return R;
+}
+
+/*! \relates ConstBlockView
+  произведение матрицы на блок матрицы
+  \param lhs - матрица \a n x \a k
+  \param rhs - блок \a k x \a m
+  \return произведение \a lhs и \a rhs, матрица \a n x \a m
+*/
+template<typename T, int n, int k, int m, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const GenericMatrix<T, n, k, S>& lhs, const ConstBlockView<T, k, m>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::mul(R.array(), m, lhs.array(), k, rhs.array(), rhs.stride(), n, k, m);
+    return R;
+}
+
+/*! \relates BlockView
+  умножение блоков матриц с записью результата в блок без промежуточной матрицы
+  \param dst - блок-результат \a n x \a m (не пересекается с множителями)
+  \param lhs - блок \a n x \a k
+  \param rhs - блок \a k x \a m
+*/
+template<typename T, int n, int k, int m>
+MATRIX_CONSTEXPR void mul (const BlockView<T, n, m>& dst, const ConstBlockView<T, n, k>& lhs, const ConstBlockView<T, k, m>& rhs) {
+    algorithms::mul(dst.array(), dst.stride(), lhs.array(), lhs.stride(), rhs.array(), rhs.stride(), n, k, m);
+}
+
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef _MATRIX_CHOLESKY_H
+#define _MATRIX_CHOLESKY_H
+
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include <ColumnMatrix.h>
+#include <identity_t.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class Cholesky
+  \brief Шаблон Cholesky - разложение Холецкого M = L L^T симметричной положительно определенной матрицы
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк и столбцов матрицы
+
+  Требует примерно вдвое меньше операций, чем LU-разложение. Если матрица не является положительно
+  определенной, это сообщается функцией positive(), а solve(), inverse(), det() и logdet() выбрасывают
+  исключение std::runtime_error (при USE_STD_EXCEPTIONS) либо возвращают нулевой результат.
+*/
+template<typename T, int n>
+class Cholesky {
+    SquareMatrix<T, n> m_L;
+    bool m_positive;
+
+    bool check (void) const {
+#if USE_STD_EXCEPTIONS
+        if (!m_positive) {
+            throw std::runtime_error("matrix is not positive definite");
+        }
+#endif
+        return m_positive;
+    }
+public:
+/*!
+  конструктор разложения
+  \param M - симметричная матрица (используется нижний треугольник)
+*/
+    explicit Cholesky (const SquareMatrix<T, n>& M) : m_L(M) {
+        m_positive = algorithms::cholesky(m_L.array(), n);
+    }
+
+/*!
+  признак положительной определенности матрицы
+  \return \a true, если разложение существует
+*/
+    bool positive (void) const {
+        return m_positive;
+    }
+
+/*!
+  определитель матрицы
+  \return произведение квадратов диагональных элементов L
+*/
+    T det (void) const {
+        if (!check()) {
+            return 0;
+        }
+        T D = 1;
+        for (int i = 0; i < n; ++i) {
+            D *= m_L[i][i];
+        }
+        return D * D;
+    }
+
+/*!
+  логарифм определителя матрицы (не переполняется для больших матриц)
+  \return удвоенная сумма логарифмов диагональных элементов L
+*/
+    T logdet (void) const {
+        if (!check()) {
+            return 0;
+        }
+        T S = 0;
+        for (int i = 0; i < n; ++i) {
+            S += std::log(m_L[i][i]);
+        }
+        return 2 * S;
+    }
+
+/*!
+  решение системы M x = b
+  \param b - правая часть
+  \return решение системы
+*/
+    ColumnMatrix<T, n> solve (const ColumnMatrix<T, n>& b) const {
+        ColumnMatrix<T, n> x = b;
+        solve(x.array(), 1);
+        return x;
+    }
+
+/*!
+  решение системы M X = B с несколькими правыми частями
+  \tparam k - количество правых частей
+  \param B - правые части, матрица \a n x \a k
+  \return решение системы, матрица \a n x \a k
+*/
+    template<int k>
+    GenericMatrix<T, n, k> solve (const GenericMatrix<T, n, k>& B) const {
+        GenericMatrix<T, n, k> X = B;
+        solve(X.array(), k);
+        return X;
+    }
+
+/*!
+  обратная матрица
+  \return матрица, обратная к M
+*/
+    SquareMatrix<T, n> inverse (void) const {
+        SquareMatrix<T, n> E = identity;
+        solve(E.array(), n);
+        return E;
+    }
+
+/*!
+  решение системы на месте
+  \param array - правые части, матрица \a n x \a k, заменяемая на решение (нулевая, если M не положительно определена)
+  \param k - количество правых частей
+*/
+    void solve (T* array, int k) const {
+        if (!check()) {
+            algorithms::null(array, n, k);
+            return;
+        }
+        algorithms::cholesky_solve(m_L.array(), array, n, k);
+    }
+
+/*!
+  множитель разложения
+  \return нижнетреугольная матрица L
+*/
+    const SquareMatrix<T, n>& matrix (void) const {
+        return m_L;
+    }
+};
+
+}
+
+#endif
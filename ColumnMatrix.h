@@ -13,50 +13,88 @@ namespace Matrix {
 */
 template<typename T, int n>
 class ColumnMatrix : public GenericMatrix<T, n, 1> {
-protected:
-    using GenericMatrix<T, n, 1>::m_array;
 public:
 /*!
   конструктор по умолчанию
 */
-    ColumnMatrix (void) : GenericMatrix<T, n, 1>() {
+    MATRIX_CONSTEXPR ColumnMatrix (void) : GenericMatrix<T, n, 1>() {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    ColumnMatrix (const ColumnMatrix<T, n>& other) : GenericMatrix<T, n, 1>(other) {
+    MATRIX_CONSTEXPR ColumnMatrix (const ColumnMatrix<T, n>& other) : GenericMatrix<T, n, 1>(other) {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    ColumnMatrix (const GenericMatrix<T, n, 1>& other) : GenericMatrix<T, n, 1>(other) {
+    MATRIX_CONSTEXPR ColumnMatrix (const GenericMatrix<T, n, 1>& other) : GenericMatrix<T, n, 1>(other) {
+    }
+
+/*!
+  конструктор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR ColumnMatrix (ColumnMatrix<T, n>&& other) noexcept : GenericMatrix<T, n, 1>(std::move(other)) {
+    }
+
+/*!
+  конструктор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR ColumnMatrix (GenericMatrix<T, n, 1>&& other) noexcept : GenericMatrix<T, n, 1>(std::move(other)) {
+    }
+
+/*!
+  конструктор из отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR ColumnMatrix (const GenericExpression<E, T, n, 1>& expression) : GenericMatrix<T, n, 1>(expression) {
     }
 
 /*!
   конструктор из литерала нулевой матрицы
 */
-    ColumnMatrix (null_t literal) : GenericMatrix<T, n, 1>(literal) {
+    MATRIX_CONSTEXPR ColumnMatrix (null_t literal) : GenericMatrix<T, n, 1>(literal) {
     }
 
 /*!
   конструктор из списка инициализации
   \param list - список инициализации
 */
-    ColumnMatrix (const std::initializer_list<T>& list) {
+    MATRIX_CONSTEXPR ColumnMatrix (const std::initializer_list<T>& list) {
         algorithms::cp(this->array(), list, n);
     }
 
+/*!
+  оператор копирования
+  \param other - копируемая матрица
+*/
+    MATRIX_CONSTEXPR ColumnMatrix& operator = (const ColumnMatrix<T, n>& other) {
+        GenericMatrix<T, n, 1>::operator = (other);
+        return *this;
+    }
+
+/*!
+  оператор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR ColumnMatrix& operator = (ColumnMatrix<T, n>&& other) noexcept {
+        GenericMatrix<T, n, 1>::operator = (std::move(other));
+        return *this;
+    }
+
 /*!
   оператор индексации
   \param row - индекс строки матрицы
   \return константная ссылка на элемент в массиве элементов матрицы
 */
-    const T& operator[] (int row) const {
-        return m_array[row][0];
+    MATRIX_CONSTEXPR const T& operator[] (int row) const {
+        return this->array()[row];
     }
 
 /*!
@@ -64,8 +102,8 @@ public:
   \param row - индекс строки матрицы
   \return ссылка на элемент в массиве элементов матрицы
 */
-    T& operator[] (int row) {
-        return m_array[row][0];
+    MATRIX_CONSTEXPR T& operator[] (int row) {
+        return this->array()[row];
     }
 };
 
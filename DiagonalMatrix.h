@@ -0,0 +1,257 @@
+#ifndef _MATRIX_DIAGONALMATRIX_H
+#define _MATRIX_DIAGONALMATRIX_H
+
+#include <null_t.h>
+#include <identity_t.h>
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class DiagonalMatrix
+  \brief Шаблон DiagonalMatrix - диагональная матрица, хранящая только элементы диагонали
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк и столбцов матрицы
+
+  Умножение слева на диагональную матрицу масштабирует строки множителя, умножение справа - столбцы.
+*/
+template<typename T, int n>
+class DiagonalMatrix {
+    T m_array[n];
+public:
+/*! \typedef ElementType
+  тип элементов матрицы
+*/
+    typedef T ElementType;
+
+/*!
+  количество строк матрицы
+*/
+    static const int rows = n;
+
+/*!
+  количество столбцов матрицы
+*/
+    static const int columns = n;
+
+/*!
+  конструктор по умолчанию
+*/
+    MATRIX_CONSTEXPR DiagonalMatrix (void) {
+    }
+
+/*!
+  конструктор из литерала нулевой матрицы
+*/
+    MATRIX_CONSTEXPR DiagonalMatrix (null_t) {
+        algorithms::null(m_array, n, 1);
+    }
+
+/*!
+  конструктор из литерала единичной матрицы
+*/
+    MATRIX_CONSTEXPR DiagonalMatrix (identity_t) {
+        for (int i = 0; i < n; ++i) {
+            m_array[i] = 1;
+        }
+    }
+
+/*!
+  конструктор из массива элементов диагонали
+  \param array - массив \a n элементов диагонали
+*/
+    explicit MATRIX_CONSTEXPR DiagonalMatrix (const T array[]) {
+        algorithms::cp(m_array, array, n);
+    }
+
+/*!
+  конструктор из списка инициализации
+  \param list - элементы диагонали
+*/
+    MATRIX_CONSTEXPR DiagonalMatrix (const std::initializer_list<T>& list) {
+        algorithms::cp(m_array, list, n);
+    }
+
+/*!
+  оператор умножения на скаляр
+  \param scalar - скалярный множитель
+  \return матрица, умноженная на \a scalar
+*/
+    MATRIX_CONSTEXPR DiagonalMatrix& operator *= (const T& scalar) {
+        algorithms::mul(m_array, scalar, n, 1);
+        return *this;
+    }
+
+/*!
+  оператор умножения на другую диагональную матрицу
+  \param other - другая матрица
+  \return матрица, умноженная на \a other
+*/
+    MATRIX_CONSTEXPR DiagonalMatrix& operator *= (const DiagonalMatrix& other) {
+        for (int i = 0; i < n; ++i) {
+            m_array[i] *= other.m_array[i];
+        }
+        return *this;
+    }
+
+/*!
+  оператор индексации
+  \param i - индекс строки и столбца
+  \return элемент диагонали (\a i, \a i)
+*/
+    MATRIX_CONSTEXPR const T& operator [] (int i) const {
+        return m_array[i];
+    }
+
+/*!
+  оператор индексации
+  \param i - индекс строки и столбца
+  \return ссылка на элемент диагонали (\a i, \a i)
+*/
+    MATRIX_CONSTEXPR T& operator [] (int i) {
+        return m_array[i];
+    }
+
+/*!
+  плотная диагональная матрица
+  \return квадратная матрица с элементами диагонали на главной диагонали
+*/
+    MATRIX_CONSTEXPR SquareMatrix<T, n> matrix (void) const {
+        return SquareMatrix<T, n>::diag(m_array);
+    }
+
+/*!
+  массив элементов диагонали
+  \return константный указатель на массив элементов диагонали
+*/
+    MATRIX_CONSTEXPR const T* array (void) const {
+        return m_array;
+    }
+
+/*!
+  массив элементов диагонали
+  \return указатель на массив элементов диагонали
+*/
+    MATRIX_CONSTEXPR T* array (void) {
+        return m_array;
+    }
+};
+
+/*! \relates DiagonalMatrix
+  оператор равенства
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR bool operator == (const DiagonalMatrix<T, n>& lhs, const DiagonalMatrix<T, n>& rhs) {
+    return algorithms::cmp(lhs.array(), rhs.array(), n, 1);
+}
+
+/*! \relates DiagonalMatrix
+  оператор неравенства
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR bool operator != (const DiagonalMatrix<T, n>& lhs, const DiagonalMatrix<T, n>& rhs) {
+    return !algorithms::cmp(lhs.array(), rhs.array(), n, 1);
+}
+
+/*! \relates DiagonalMatrix
+  произведение диагональных матриц
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR DiagonalMatrix<T, n> operator * (const DiagonalMatrix<T, n>& lhs, const DiagonalMatrix<T, n>& rhs) {
+    DiagonalMatrix<T, n> D = lhs;
+    return D *= rhs;
+}
+
+/*! \relates DiagonalMatrix
+  произведение диагональной матрицы и скаляра
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR DiagonalMatrix<T, n> operator * (const DiagonalMatrix<T, n>& lhs, const T& rhs) {
+    DiagonalMatrix<T, n> D = lhs;
+    return D *= rhs;
+}
+
+/*! \relates DiagonalMatrix
+  произведение скаляра и диагональной матрицы
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR DiagonalMatrix<T, n> operator * (const T& lhs, const DiagonalMatrix<T, n>& rhs) {
+    DiagonalMatrix<T, n> D = rhs;
+    return D *= lhs;
+}
+
+/*! \relates DiagonalMatrix
+  масштабирование строк матрицы за O(n * m)
+  \param lhs - диагональная матрица \a n x \a n
+  \param rhs - матрица \a n x \a m
+  \return матрица \a rhs, строка \a i которой умножена на \a lhs[i]
+*/
+template<typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const DiagonalMatrix<T, n>& lhs, const GenericMatrix<T, n, m, S>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::scale_rows(R.array(), rhs.array(), lhs.array(), n, m);
+    return R;
+}
+
+/*! \relates DiagonalMatrix
+  масштабирование столбцов матрицы за O(n * m)
+  \param lhs - матрица \a n x \a m
+  \param rhs - диагональная матрица \a m x \a m
+  \return матрица \a lhs, столбец \a j которой умножен на \a rhs[j]
+*/
+template<typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const GenericMatrix<T, n, m, S>& lhs, const DiagonalMatrix<T, m>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::scale_columns(R.array(), lhs.array(), rhs.array(), n, m);
+    return R;
+}
+
+/*! \relates DiagonalMatrix
+  вычисление обратной матрицы
+  \param D - диагональная матрица
+  \return диагональная матрица из обратных элементов (нулевая в случае вырожденности \a D)
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR DiagonalMatrix<T, n> inverse (const DiagonalMatrix<T, n>& D) {
+    DiagonalMatrix<T, n> R;
+    for (int i = 0; i < n; ++i) {
+        if (algorithms::abs(D[i]) <= precision<T>()) {
+            return null;
+        }
+        R[i] = 1 / D[i];
+    }
+    return R;
+}
+
+/*! \relates DiagonalMatrix
+  вычисление определителя матрицы
+  \param D - диагональная матрица
+  \return произведение элементов диагонали
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR T det (const DiagonalMatrix<T, n>& D) {
+    T R = 1;
+    for (int i = 0; i < n; ++i) {
+        R *= D[i];
+    }
+    return R;
+}
+
+/*! \relates DiagonalMatrix
+  вычисление следа матрицы
+  \param D - диагональная матрица
+  \return сумма элементов диагонали
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR T tr (const DiagonalMatrix<T, n>& D) {
+    T R = 0;
+    for (int i = 0; i < n; ++i) {
+        R += D[i];
+    }
+    return R;
+}
+
+}
+
+#endif
@@ -0,0 +1,591 @@
+#ifndef _MATRIX_DYNAMICMATRIX_H
+#define _MATRIX_DYNAMICMATRIX_H
+
+#include <utility>
+#include <null_t.h>
+#include <identity_t.h>
+#include <GenericMatrix.h>
+#include "algorithms.h"
+#include "aligned.h"
+#include "fixed.h"
+
+namespace Matrix {
+
+/*! \class DynamicMatrix
+  \brief Шаблон DynamicMatrix - класс реализации общих математических операций с матрицами, размеры которых задаются во время выполнения
+  \tparam T - тип элементов матрицы
+
+  Элементы хранятся построчно в куче, массив выровнен по MEMORY_ALIGNMENT. Перемещение матрицы
+  не копирует элементы. Конструкторы, заполняющие элементы, делегируют выделение массива
+  конструктору размеров, поэтому при исключении во время заполнения массив освобождается. Операции над матрицами несовпадающих размеров вызывают исключение.
+*/
+template<typename T>
+class DynamicMatrix {
+public:
+/*! \typedef ElementType
+  тип элементов матрицы
+*/
+    typedef T ElementType;
+private:
+    int m_rows;
+    int m_columns;
+    T* m_array;
+public:
+/*!
+  конструктор пустой матрицы 0 x 0
+*/
+    DynamicMatrix (void) : m_rows(0), m_columns(0), m_array(nullptr) {
+    }
+
+/*!
+  конструктор матрицы заданного размера (элементы не инициализируются)
+  \param rows - количество строк матрицы
+  \param columns - количество столбцов матрицы
+*/
+    DynamicMatrix (int rows, int columns) : m_rows(rows), m_columns(columns), m_array(algorithms::allocate<T>(rows * columns)) {
+    }
+
+/*!
+  конструктор нулевой матрицы заданного размера
+  \param rows - количество строк матрицы
+  \param columns - количество столбцов матрицы
+*/
+    DynamicMatrix (int rows, int columns, null_t) : DynamicMatrix(rows, columns) {
+        algorithms::null(m_array, m_rows, m_columns);
+    }
+
+/*!
+  конструктор единичной матрицы заданного размера
+  \param n - количество строк и столбцов матрицы
+*/
+    DynamicMatrix (int n, identity_t) : DynamicMatrix(n, n) {
+        if (n > 0) {
+            algorithms::identity(m_array, n);
+        }
+    }
+
+/*!
+  конструктор из списка инициализации (размеры определяются по списку)
+  \param list - список инициализации
+*/
+    DynamicMatrix (const std::initializer_list<std::initializer_list<T>>& list) : DynamicMatrix(list.size(), list.size() ? list.begin()->size() : 0) {
+        algorithms::cp(m_array, list, m_rows, m_columns);
+    }
+
+/*!
+  конструктор из матрицы фиксированного размера
+  \param M - матрица \a n x \a m
+*/
+    template<int n, int m, typename S>
+    DynamicMatrix (const GenericMatrix<T, n, m, S>& M) : DynamicMatrix(n, m) {
+        algorithms::cp(m_array, M.array(), n, m);
+    }
+
+/*!
+  конструктор копирования
+  \param other - копируемая матрица
+*/
+    DynamicMatrix (const DynamicMatrix& other) : DynamicMatrix(other.m_rows, other.m_columns) {
+        algorithms::cp(m_array, other.m_array, m_rows, m_columns);
+    }
+
+/*!
+  конструктор перемещения
+  \param other - перемещаемая матрица (становится пустой)
+*/
+    DynamicMatrix (DynamicMatrix&& other) noexcept : m_rows(other.m_rows), m_columns(other.m_columns), m_array(other.m_array) {
+        other.m_rows = 0;
+        other.m_columns = 0;
+        other.m_array = nullptr;
+    }
+
+/*!
+  деструктор
+*/
+    ~DynamicMatrix (void) {
+        algorithms::deallocate(m_array);
+    }
+
+/*!
+  оператор копирования (память перераспределяется только при изменении количества элементов)
+  \param other - копируемая матрица
+*/
+    DynamicMatrix& operator = (const DynamicMatrix& other) {
+        if (this != &other) {
+            resize(other.m_rows, other.m_columns);
+            algorithms::cp(m_array, other.m_array, m_rows, m_columns);
+        }
+        return *this;
+    }
+
+/*!
+  оператор перемещения
+  \param other - перемещаемая матрица
+*/
+    DynamicMatrix& operator = (DynamicMatrix&& other) noexcept {
+        std::swap(m_rows, other.m_rows);
+        std::swap(m_columns, other.m_columns);
+        std::swap(m_array, other.m_array);
+        return *this;
+    }
+
+/*!
+  оператор обнуления матрицы
+*/
+    DynamicMatrix& operator = (null_t) {
+        algorithms::null(m_array, m_rows, m_columns);
+        return *this;
+    }
+
+/*!
+  оператор присваивания квадратной матрице значения единичной матрицы
+*/
+    DynamicMatrix& operator = (identity_t) {
+#if USE_STD_EXCEPTIONS
+        if (m_rows != m_columns) {
+            throw std::runtime_error("matrix is not square");
+        }
+#endif
+        if (m_rows > 0) {
+            algorithms::identity(m_array, m_rows);
+        }
+        return *this;
+    }
+
+/*!
+  оператор умножения на скаляр
+  \param scalar - скалярный множитель
+  \return матрица, умноженная на \a scalar
+*/
+    DynamicMatrix& operator *= (const T& scalar) {
+        algorithms::mul(m_array, scalar, m_rows, m_columns);
+        return *this;
+    }
+
+/*!
+  оператор прибавления другой матрицы
+  \param other - другая матрица того же размера
+  \return матрица, увеличенная на \a other
+*/
+    DynamicMatrix& operator += (const DynamicMatrix& other) {
+#if USE_STD_EXCEPTIONS
+        if ((other.m_rows != m_rows) || (other.m_columns != m_columns)) {
+            throw std::runtime_error("matrix size mismatch");
+        }
+#endif
+        algorithms::add(m_array, other.m_array, m_rows, m_columns);
+        return *this;
+    }
+
+/*!
+  оператор вычитания другой матрицы
+  \param other - другая матрица того же размера
+  \return матрица, уменьшенная на \a other
+*/
+    DynamicMatrix& operator -= (const DynamicMatrix& other) {
+#if USE_STD_EXCEPTIONS
+        if ((other.m_rows != m_rows) || (other.m_columns != m_columns)) {
+            throw std::runtime_error("matrix size mismatch");
+        }
+#endif
+        algorithms::sub(m_array, other.m_array, m_rows, m_columns);
+        return *this;
+    }
+
+/*!
+  оператор умножения справа на другую матрицу
+  \param other - другая матрица, количество строк которой равно количеству столбцов матрицы
+  \return матрица, умноженная справа на \a other
+*/
+    DynamicMatrix& operator *= (const DynamicMatrix& other);
+
+/*!
+  оператор индексации
+  \param row - индекс строки матрицы
+  \return константный указатель на строку в массиве элементов матрицы
+*/
+    const T* operator [] (int row) const {
+        return m_array + row * m_columns;
+    }
+
+/*!
+  оператор индексации
+  \param row - индекс строки матрицы
+  \return указатель на строку в массиве элементов матрицы
+*/
+    T* operator [] (int row) {
+        return m_array + row * m_columns;
+    }
+
+/*!
+  одновременное вычисление определителя и обратной матрицы (в случае ненулевого определителя)
+  \param inverse - ссылка на матрицу, которая будет приравнена к обратной (не поменяется в случае вырожденности матрицы)
+  \return определитель матрицы
+*/
+    T det (DynamicMatrix& inverse) const;
+
+/*!
+  изменение размера матрицы (значения элементов после изменения не определены)
+  \param rows - новое количество строк
+  \param columns - новое количество столбцов
+*/
+    void resize (int rows, int columns) {
+        if (rows * columns != m_rows * m_columns) {
+            algorithms::deallocate(m_array);
+            m_array = nullptr;
+            m_rows = 0;
+            m_columns = 0;
+            m_array = algorithms::allocate<T>(rows * columns);
+        }
+        m_rows = rows;
+        m_columns = columns;
+    }
+
+/*!
+  количество строк матрицы
+*/
+    int rows (void) const {
+        return m_rows;
+    }
+
+/*!
+  количество столбцов матрицы
+*/
+    int columns (void) const {
+        return m_columns;
+    }
+
+/*!
+  массив элементов матрицы
+  \return константный указатель на начало массива элементов матрицы
+*/
+    const T* array (void) const {
+        return m_array;
+    }
+
+/*!
+  массив элементов матрицы
+  \return указатель на начало массива элементов матрицы
+*/
+    T* array (void) {
+        return m_array;
+    }
+};
+
+template<typename T>
+DynamicMatrix<T>& DynamicMatrix<T>::operator *= (const DynamicMatrix<T>& other) {
+    return *this = *this * other;
+}
+
+template<typename T>
+T DynamicMatrix<T>::det (DynamicMatrix<T>& inverse) const {
+#if USE_STD_EXCEPTIONS
+    if (m_rows != m_columns) {
+        throw std::runtime_error("matrix is not square");
+    }
+#endif
+    int n = m_rows;
+    if (n == 0) {
+        return 1;
+    }
+    if (n <= algorithms::fixed::size) {
+        T R[algorithms::fixed::size * algorithms::fixed::size];
+        T D = algorithms::fixed::inverse(R, m_array, n);
+        if (D != 0) {
+            inverse.resize(n, n);
+            algorithms::cp(inverse.array(), R, n, n);
+        }
+        return D;
+    }
+    algorithms::Scratch<T> A(n * n);
+    algorithms::cp(A.data(), m_array, n * n);
+    algorithms::Scratch<int> pivot(n);
+    bool singular;
+    T D = algorithms::gauss_jordan(A.data(), pivot.data(), n, &singular);
+    if (!singular) {
+        inverse.resize(n, n);
+        algorithms::cp(inverse.array(), A.data(), n * n);
+    }
+    return D;
+}
+
+/*! \relates DynamicMatrix
+  оператор равенства
+  \param lhs - левая сторона равенства
+  \param rhs - правая сторона равенства
+  \return \a true, если матрицы \a lhs и \a rhs одного размера и совпадают поэлементно
+*/
+template<typename T>
+bool operator == (const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs) {
+    if ((lhs.rows() != rhs.rows()) || (lhs.columns() != rhs.columns())) {
+        return false;
+    }
+    return algorithms::cmp(lhs.array(), rhs.array(), lhs.rows(), lhs.columns());
+}
+
+/*! \relates DynamicMatrix
+  оператор неравенства
+  \param lhs - левая сторона неравенства
+  \param rhs - правая сторона неравенства
+  \return \a true, если матрицы \a lhs и \a rhs разного размера или отличаются хотя бы в одном элементе
+*/
+template<typename T>
+bool operator != (const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs) {
+    return !(lhs == rhs);
+}
+
+/*! \relates DynamicMatrix
+  оператор сложения
+  \param lhs - первое слагаемое
+  \param rhs - второе слагаемое того же размера
+  \return сумма матриц \a lhs и \a rhs
+*/
+template<typename T>
+DynamicMatrix<T> operator + (const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs) {
+    DynamicMatrix<T> M = lhs;
+    M += rhs;
+    return M;
+}
+
+/*! \relates DynamicMatrix
+  оператор унарного минуса
+  \param rhs - матрица
+  \return матрица, противоположная к \a rhs
+*/
+template<typename T>
+DynamicMatrix<T> operator - (const DynamicMatrix<T>& rhs) {
+    DynamicMatrix<T> M(rhs.rows(), rhs.columns(), null);
+    M -= rhs;
+    return M;
+}
+
+/*! \relates DynamicMatrix
+  оператор вычитания
+  \param lhs - уменьшаемая матрица
+  \param rhs - вычитаемая матрица того же размера
+  \return разность матриц \a lhs и \a rhs
+*/
+template<typename T>
+DynamicMatrix<T> operator - (const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs) {
+    DynamicMatrix<T> M = lhs;
+    M -= rhs;
+    return M;
+}
+
+/*! \relates DynamicMatrix
+  оператор умножения матрицы и скаляра
+  \param lhs - матричный множитель
+  \param rhs - скалярный множитель
+  \return произведение матрицы \a lhs и скаляра \a rhs
+*/
+template<typename T>
+DynamicMatrix<T> operator * (const DynamicMatrix<T>& lhs, const T& rhs) {
+    DynamicMatrix<T> M = lhs;
+    M *= rhs;
+    return M;
+}
+
+/*! \relates DynamicMatrix
+  оператор умножения скаляра и матрицы
+  \param lhs - скалярный множитель
+  \param rhs - матричный множитель
+  \return произведение скаляра \a lhs и матрицы \a rhs
+*/
+template<typename T>
+DynamicMatrix<T> operator * (const T& lhs, const DynamicMatrix<T>& rhs) {
+    DynamicMatrix<T> M = rhs;
+    M *= lhs;
+    return M;
+}
+
+/*! \relates DynamicMatrix
+  оператор умножения матриц
+  \param lhs - первый множитель, матрица n x k
+  \param rhs - второй множитель, матрица k x m
+  \return произведение матриц \a lhs и \a rhs, матрица n x m
+*/
+template<typename T>
+DynamicMatrix<T> operator * (const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs) {
+#if USE_STD_EXCEPTIONS
+    if (lhs.columns() != rhs.rows()) {
+        throw std::runtime_error("matrix size mismatch");
+    }
+#endif
+    DynamicMatrix<T> M(lhs.rows(), rhs.columns());
+    algorithms::mul(M.array(), lhs.array(), rhs.array(), lhs.rows(), lhs.columns(), rhs.columns());
+    return M;
+}
+
+/*! \relates DynamicMatrix
+  транспонирование матрицы
+  \param M - матрица n x m
+  \return матрица m x n - транспонированная \a M
+*/
+template<typename T>
+DynamicMatrix<T> transpose (const DynamicMatrix<T>& M) {
+    DynamicMatrix<T> R(M.columns(), M.rows());
+    algorithms::transpose(R.array(), M.array(), M.rows(), M.columns());
+    return R;
+}
+
+/*! \relates DynamicMatrix
+  конкатенация матриц
+  \param lhs - матрица n x m1
+  \param rhs - матрица n x m2
+  \return матрица n x (m1 + m2), полученная конкатенацией (по горизонтали) матриц \a lhs и \a rhs
+*/
+template<typename T>
+DynamicMatrix<T> cat (const DynamicMatrix<T>& lhs, const DynamicMatrix<T>& rhs) {
+#if USE_STD_EXCEPTIONS
+    if (lhs.rows() != rhs.rows()) {
+        throw std::runtime_error("matrix size mismatch");
+    }
+#endif
+    DynamicMatrix<T> M(lhs.rows(), lhs.columns() + rhs.columns());
+    algorithms::cat(M.array(), lhs.array(), rhs.array(), lhs.rows(), lhs.columns(), rhs.columns());
+    return M;
+}
+
+/*! \relates DynamicMatrix
+  минор матрицы
+  \param M - матрица
+  \param i0 - верхняя строка минора
+  \param j0 - левый столбец минора
+  \param n1 - количество строк минора
+  \param m1 - количество столбцов минора
+  \return минор матрицы \a M, матрица \a n1 x \a m1
+*/
+template<typename T>
+DynamicMatrix<T> minor (const DynamicMatrix<T>& M, int i0, int j0, int n1, int m1) {
+#if USE_STD_EXCEPTIONS
+    if ((i0 < 0) || (j0 < 0) || (i0 + n1 > M.rows()) || (j0 + m1 > M.columns())) {
+        throw std::runtime_error("matrix size mismatch");
+    }
+#endif
+    DynamicMatrix<T> R(n1, m1);
+    algorithms::minor(R.array(), M.array(), i0, j0, M.rows(), M.columns(), n1, m1);
+    return R;
+}
+
+/*! \relates DynamicMatrix
+  дополнение матрицы нулями до матрицы большего размера
+  \param M - матрица
+  \param i0 - индекс верхней строки матрицы в дополненной матрице
+  \param j0 - индекс левого столбца матрицы в дополненной матрице
+  \param n1 - количество строк, до которого дополняется матрица
+  \param m1 - количество столбцов, до которого дополняется матрица
+  \return матрица \a n1 x \a m1, содержащая матрицу \a M в качестве минора
+*/
+template<typename T>
+DynamicMatrix<T> expand (const DynamicMatrix<T>& M, int i0, int j0, int n1, int m1) {
+#if USE_STD_EXCEPTIONS
+    if ((i0 < 0) || (j0 < 0) || (i0 + M.rows() > n1) || (j0 + M.columns() > m1)) {
+        throw std::runtime_error("matrix size mismatch");
+    }
+#endif
+    DynamicMatrix<T> R(n1, m1);
+    algorithms::expand(R.array(), M.array(), i0, j0, M.rows(), M.columns(), n1, m1);
+    return R;
+}
+
+/*! \relates DynamicMatrix
+  "норма" матрицы
+  \param M - матрица
+  \return сумма квадратов элементов матрицы \a M
+*/
+template<typename T>
+T norm (const DynamicMatrix<T>& M) {
+    return algorithms::norm(M.array(), M.rows(), M.columns());
+}
+
+/*! \relates DynamicMatrix
+  вычисление обратной матрицы
+  \param M - квадратная матрица
+  \return матрица, обратная к \a M (нулевая матрица в случае вырожденности \a M)
+*/
+template<typename T>
+DynamicMatrix<T> inverse (const DynamicMatrix<T>& M) {
+    DynamicMatrix<T> inverse(M.rows(), M.columns(), null);
+    M.det(inverse);
+    return inverse;
+}
+
+/*! \relates DynamicMatrix
+  вычисление определителя матрицы (по явной формуле для матриц до 4 x 4, иначе LU-разложением)
+  \param M - квадратная матрица
+  \return определитель \a M (0 для вырожденной матрицы, как в M.det(inverse))
+*/
+template<typename T>
+T det (const DynamicMatrix<T>& M) {
+#if USE_STD_EXCEPTIONS
+    if (M.rows() != M.columns()) {
+        throw std::runtime_error("matrix is not square");
+    }
+#endif
+    int n = M.rows();
+    if (n == 0) {
+        return 1;
+    }
+    if (n <= algorithms::fixed::size) {
+        T D = algorithms::fixed::det(M.array(), n);
+        return algorithms::fixed::singular(M.array(), D, n) ? 0 : D;
+    }
+    algorithms::Scratch<T> LU(n * n);
+    algorithms::cp(LU.data(), M.array(), n * n);
+    algorithms::Scratch<int> pivot(n);
+    return algorithms::lu(LU.data(), pivot.data(), n);
+}
+
+/*! \relates DynamicMatrix
+  вычисление следа матрицы
+  \param M - квадратная матрица
+  \return след \a M
+*/
+template<typename T>
+T tr (const DynamicMatrix<T>& M) {
+#if USE_STD_EXCEPTIONS
+    if (M.rows() != M.columns()) {
+        throw std::runtime_error("matrix is not square");
+    }
+#endif
+    if (M.rows() == 0) {
+        return 0;
+    }
+    return algorithms::tr(M.array(), M.rows());
+}
+
+/*! \relates DynamicMatrix
+  запись матрицы в поток вывода
+  \tparam Stream - тип потока вывода
+  \param stream - поток вывода
+  \param M - матрица
+  \return поток вывода
+*/
+template<typename T, typename Stream>
+Stream& operator << (Stream& stream, const DynamicMatrix<T>& M) {
+    return algorithms::print(stream, M.array(), M.rows(), M.columns());
+}
+
+/*! \relates DynamicMatrix
+  чтение матрицы из потока ввода в бинарном виде (размер матрицы берется из потока)
+  \tparam Stream - тип потока ввода
+  \param stream - поток ввода
+  \param M - матрица
+  \return поток ввода
+*/
+template<typename T, typename Stream>
+Stream& operator >> (Stream& stream, DynamicMatrix<T>& M) {
+    int n, m;
+    stream >> n >> m;
+    M.resize(n, m);
+    T* _array = M.array();
+    int cnt = n * m;
+    while (cnt--) {
+        stream >> *_array++;
+    }
+    return stream;
+}
+
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef _MATRIX_GENERICEXPRESSION_H
+#define _MATRIX_GENERICEXPRESSION_H
+
+#include "constexpr.h"
+
+namespace Matrix {
+
+template<typename T, int n, int m, typename S>
+class GenericMatrix;
+
+/*! \class GenericExpression
+  \brief Шаблон GenericExpression - базовый класс отложенных поэлементных выражений над матрицами
+  \tparam E - тип выражения-наследника
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк матрицы
+  \tparam m - количество столбцов матрицы
+
+  Выражения вычисляются за один проход по элементам при присваивании матрице,
+  промежуточные матрицы при этом не создаются.
+*/
+template<typename E, typename T, int n, int m>
+class GenericExpression {
+public:
+/*!
+  выражение-наследник
+  \return ссылка на выражение-наследник
+*/
+    MATRIX_CONSTEXPR const E& expression (void) const {
+        return static_cast<const E&>(*this);
+    }
+
+/*!
+  элемент выражения
+  \param index - индекс элемента в массиве элементов матрицы
+  \return значение элемента
+*/
+    MATRIX_CONSTEXPR T item (int index) const {
+        return expression().item(index);
+    }
+};
+
+/*! \class ExpressionOperand
+  \brief способ хранения операнда в узле выражения: узлы хранятся по значению, матрицы - по ссылке
+  \tparam E - тип операнда
+*/
+template<typename E>
+struct ExpressionOperand {
+    typedef const E type;
+};
+
+template<typename T, int n, int m, typename S>
+struct ExpressionOperand<GenericMatrix<T, n, m, S>> {
+    typedef const GenericMatrix<T, n, m, S>& type;
+};
+
+/*! \class GenericSum
+  \brief Шаблон GenericSum - отложенная сумма двух выражений
+*/
+template<typename L, typename R, typename T, int n, int m>
+class GenericSum : public GenericExpression<GenericSum<L, R, T, n, m>, T, n, m> {
+    typename ExpressionOperand<L>::type m_lhs;
+    typename ExpressionOperand<R>::type m_rhs;
+public:
+    MATRIX_CONSTEXPR GenericSum (const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs) {
+    }
+
+    MATRIX_CONSTEXPR T item (int index) const {
+        return m_lhs.item(index) + m_rhs.item(index);
+    }
+};
+
+/*! \class GenericDifference
+  \brief Шаблон GenericDifference - отложенная разность двух выражений
+*/
+template<typename L, typename R, typename T, int n, int m>
+class GenericDifference : public GenericExpression<GenericDifference<L, R, T, n, m>, T, n, m> {
+    typename ExpressionOperand<L>::type m_lhs;
+    typename ExpressionOperand<R>::type m_rhs;
+public:
+    MATRIX_CONSTEXPR GenericDifference (const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs) {
+    }
+
+    MATRIX_CONSTEXPR T item (int index) const {
+        return m_lhs.item(index) - m_rhs.item(index);
+    }
+};
+
+/*! \class GenericNegation
+  \brief Шаблон GenericNegation - отложенное выражение, противоположное к данному
+*/
+template<typename E, typename T, int n, int m>
+class GenericNegation : public GenericExpression<GenericNegation<E, T, n, m>, T, n, m> {
+    typename ExpressionOperand<E>::type m_rhs;
+public:
+    explicit MATRIX_CONSTEXPR GenericNegation (const E& rhs) : m_rhs(rhs) {
+    }
+
+    MATRIX_CONSTEXPR T item (int index) const {
+        return -m_rhs.item(index);
+    }
+};
+
+/*! \class GenericScaled
+  \brief Шаблон GenericScaled - отложенное произведение выражения и скаляра
+*/
+template<typename E, typename T, int n, int m>
+class GenericScaled : public GenericExpression<GenericScaled<E, T, n, m>, T, n, m> {
+    typename ExpressionOperand<E>::type m_lhs;
+    T m_scalar;
+public:
+    MATRIX_CONSTEXPR GenericScaled (const E& lhs, const T& scalar) : m_lhs(lhs), m_scalar(scalar) {
+    }
+
+    MATRIX_CONSTEXPR T item (int index) const {
+        return m_lhs.item(index) * m_scalar;
+    }
+};
+
+}
+
+#endif
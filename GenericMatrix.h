@@ -2,7 +2,10 @@
 #define _MATRIX_GENERICMATRIX_H
 
 #include <null_t.h>
+#include <GenericExpression.h>
 #include "algorithms.h"
+#include "storage.h"
+#include "fixed.h"
 
 namespace Matrix {
 
@@ -11,9 +14,10 @@ namespace Matrix {
   \tparam T - тип элементов матрицы
   \tparam n - количество строк матрицы
   \tparam m - количество столбцов матрицы
+  \tparam S - способ хранения элементов (storage::Inline или storage::Heap, по умолчанию выбирается по размеру матрицы)
 */
-template<typename T, int n, int m>
-class GenericMatrix {
+template<typename T, int n, int m, typename S = typename storage::Default<T, n * m>::type>
+class GenericMatrix : public GenericExpression<GenericMatrix<T, n, m, S>, T, n, m> {
 public:
 /*! \typedef ElementType
   тип элементов матрицы
@@ -35,12 +39,12 @@ private:
 */
     class RowConst {
         const T* m_row;
-        RowConst (const T* row) : m_row(row) {
+        MATRIX_CONSTEXPR RowConst (const T* row) : m_row(row) {
         }
         RowConst (const RowConst& other);
         RowConst& operator = (const RowConst& other);
     public:
-        const T& operator [] (int column) const {
+        MATRIX_CONSTEXPR const T& operator [] (int column) const {
             return m_row[column];
         }
     friend const RowConst GenericMatrix::operator [] (int) const;
@@ -51,40 +55,46 @@ private:
 */
     class Row {
         T* m_row;
-        Row (T* row) : m_row(row) {
+        MATRIX_CONSTEXPR Row (T* row) : m_row(row) {
         }
         Row (const Row& other);
         Row& operator = (const Row& other);
     public:
-        T& operator [] (int column) const {
+        MATRIX_CONSTEXPR T& operator [] (int column) const {
             return m_row[column];
         }
     friend const Row GenericMatrix::operator [] (int);
     };
 protected:
 /*!
-  двумерный массив элементов матрицы
+  массив элементов матрицы (построчно)
 */
-    T m_array[n][m];
+    storage::Array<T, n * m, S> m_array;
 public:
 /*!
   конструктор по умолчанию
 */
-    GenericMatrix (void) {
+    MATRIX_CONSTEXPR GenericMatrix (void) {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    GenericMatrix (const GenericMatrix& other) {
-        algorithms::cp(array(), other.array(), n, m);
+    MATRIX_CONSTEXPR GenericMatrix (const GenericMatrix& other) : m_array(other.m_array) {
+    }
+
+/*!
+  конструктор перемещения (элементы, хранящиеся в куче, не копируются)
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR GenericMatrix (GenericMatrix&& other) noexcept : m_array(std::move(other.m_array)) {
     }
 
 /*!
   конструктор из литерала нулевой матрицы
 */
-    GenericMatrix (null_t) {
+    MATRIX_CONSTEXPR GenericMatrix (null_t) {
         algorithms::null(array(), n, m);
     }
 
@@ -92,24 +102,51 @@ public:
   конструктор из списка инициализации
   \param list - список инициализации
 */
-    GenericMatrix (const std::initializer_list<std::initializer_list<T>>& list) {
+    MATRIX_CONSTEXPR GenericMatrix (const std::initializer_list<std::initializer_list<T>>& list) {
         algorithms::cp(array(), list, n, m);
     }
 
+/*!
+  конструктор из отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR GenericMatrix (const GenericExpression<E, T, n, m>& expression) {
+        algorithms::eval(array(), expression.expression(), n, m);
+    }
 
 /*!
   оператор копирования
   \param other - копируемая матрица
 */
-    GenericMatrix& operator = (const GenericMatrix& other) {
-        algorithms::cp(array(), other.array(), n, m);
+    MATRIX_CONSTEXPR GenericMatrix& operator = (const GenericMatrix& other) {
+        m_array = other.m_array;
+        return *this;
+    }
+
+/*!
+  оператор перемещения (элементы, хранящиеся в куче, не копируются)
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR GenericMatrix& operator = (GenericMatrix&& other) noexcept {
+        m_array = std::move(other.m_array);
+        return *this;
+    }
+
+/*!
+  оператор присваивания отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR GenericMatrix& operator = (const GenericExpression<E, T, n, m>& expression) {
+        algorithms::eval(array(), expression.expression(), n, m);
         return *this;
     }
 
 /*!
   оператор обнуления матрицы
 */
-    GenericMatrix& operator = (null_t) {
+    MATRIX_CONSTEXPR GenericMatrix& operator = (null_t) {
         algorithms::null(array(), n, m);
         return *this;
     }
@@ -119,7 +156,7 @@ public:
   \param scalar - скалярный множитель
   \return матрица, умноженная на \a scalar
 */
-    GenericMatrix& operator *= (const T& scalar) {
+    MATRIX_CONSTEXPR GenericMatrix& operator *= (const T& scalar) {
         algorithms::mul(array(), scalar, n, m);
         return *this;
     }
@@ -129,7 +166,7 @@ public:
   \param other - другая матрица
   \return матрица, увеличенная на \a other
 */
-    GenericMatrix& operator += (const GenericMatrix& other) {
+    MATRIX_CONSTEXPR GenericMatrix& operator += (const GenericMatrix& other) {
         algorithms::add(array(), other.array(), n, m);
         return *this;
     }
@@ -139,18 +176,40 @@ public:
   \param other - другая матрица
   \return матрица, уменьшенная на \a other
 */
-    GenericMatrix& operator -= (const GenericMatrix& other) {
+    MATRIX_CONSTEXPR GenericMatrix& operator -= (const GenericMatrix& other) {
         algorithms::sub(array(), other.array(), n, m);
         return *this;
     }
 
+/*!
+  оператор прибавления отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+  \return матрица, увеличенная на \a expression
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR GenericMatrix& operator += (const GenericExpression<E, T, n, m>& expression) {
+        algorithms::eval_add(array(), expression.expression(), n, m);
+        return *this;
+    }
+
+/*!
+  оператор вычитания отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+  \return матрица, уменьшенная на \a expression
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR GenericMatrix& operator -= (const GenericExpression<E, T, n, m>& expression) {
+        algorithms::eval_sub(array(), expression.expression(), n, m);
+        return *this;
+    }
+
 /*!
   оператор индексации
   \param row - индекс строки матрицы
   \return объект \a RowConst - константный указатель на строку в двумерном массиве элементов матрицы
 */
-    const RowConst operator [] (int row) const {
-        return RowConst(m_array[row]);
+    MATRIX_CONSTEXPR const RowConst operator [] (int row) const {
+        return RowConst(array() + row * m);
     }
 
 /*!
@@ -158,24 +217,33 @@ public:
   \param row - индекс строки матрицы
   \return объект \a Row - указатель на строку в двумерном массиве элементов матрицы
 */
-    const Row operator [] (int row) {
-        return Row(m_array[row]);
+    MATRIX_CONSTEXPR const Row operator [] (int row) {
+        return Row(array() + row * m);
+    }
+
+/*!
+  элемент матрицы как узла отложенного выражения
+  \param index - индекс элемента в массиве элементов матрицы
+  \return значение элемента
+*/
+    MATRIX_CONSTEXPR T item (int index) const {
+        return array()[index];
     }
 
 /*!
   массив элементов матрицы
   \return константный указатель на начало массива элементов матрицы
 */
-    const T* array (void) const {
-        return (const T*) m_array;
+    MATRIX_CONSTEXPR const T* array (void) const {
+        return m_array.data();
     }
 
 /*!
   массив элементов матрицы
   \return указатель на начало массива элементов матрицы
 */
-    T* array (void) {
-        return (T*) m_array;
+    MATRIX_CONSTEXPR T* array (void) {
+        return m_array.data();
     }
 };
 
@@ -185,8 +253,8 @@ public:
   \param rhs - правая сторона равенства
   \return \a true, если матрицы \a lhs и \a rhs совпадают поэлементно
 */
-template<typename T, int n, int m>
-bool operator == (const GenericMatrix<T, n, m>& lhs, const GenericMatrix<T, n, m>& rhs) {
+template<typename T, int n, int m, typename S1, typename S2>
+MATRIX_CONSTEXPR bool operator == (const GenericMatrix<T, n, m, S1>& lhs, const GenericMatrix<T, n, m, S2>& rhs) {
     return algorithms::cmp(lhs.array(), rhs.array(), n, m);
 }
 
@@ -196,68 +264,85 @@ bool operator == (const GenericMatrix<T, n, m>& lhs, const GenericMatrix<T, n, m
   \param rhs - правая сторона неравенства
   \return \a true, если матрицы \a lhs и \a rhs отличаются хотя бы в одном элементе
 */
-template<typename T, int n, int m>
-bool operator != (const GenericMatrix<T, n, m>& lhs, const GenericMatrix<T, n, m>& rhs) {
+template<typename T, int n, int m, typename S1, typename S2>
+MATRIX_CONSTEXPR bool operator != (const GenericMatrix<T, n, m, S1>& lhs, const GenericMatrix<T, n, m, S2>& rhs) {
     return !algorithms::cmp(lhs.array(), rhs.array(), n, m);
 }
 
-/*! \relates GenericMatrix
+/*! \relates GenericExpression
+  оператор равенства
+  \param lhs - левая сторона равенства
+  \param rhs - правая сторона равенства
+  \return \a true, если выражения \a lhs и \a rhs совпадают поэлементно
+*/
+template<typename L, typename R, typename T, int n, int m>
+MATRIX_CONSTEXPR bool operator == (const GenericExpression<L, T, n, m>& lhs, const GenericExpression<R, T, n, m>& rhs) {
+    return algorithms::eval_cmp(lhs.expression(), rhs.expression(), n, m);
+}
+
+/*! \relates GenericExpression
+  оператор неравенства
+  \param lhs - левая сторона неравенства
+  \param rhs - правая сторона неравенства
+  \return \a true, если выражения \a lhs и \a rhs отличаются хотя бы в одном элементе
+*/
+template<typename L, typename R, typename T, int n, int m>
+MATRIX_CONSTEXPR bool operator != (const GenericExpression<L, T, n, m>& lhs, const GenericExpression<R, T, n, m>& rhs) {
+    return !algorithms::eval_cmp(lhs.expression(), rhs.expression(), n, m);
+}
+
+/*! \relates GenericExpression
   оператор сложения
   \param lhs - первое слагаемое
   \param rhs - второе слагаемое
-  \return сумма матриц \a lhs и \a rhs
+  \return отложенная сумма \a lhs и \a rhs
 */
-template<typename T, int n, int m>
-const GenericMatrix<T, n, m> operator + (const GenericMatrix<T, n, m>& lhs, const GenericMatrix<T, n, m>& rhs) {
-    GenericMatrix<T, n, m> M = lhs;
-    return M += rhs;
+template<typename L, typename R, typename T, int n, int m>
+MATRIX_CONSTEXPR const GenericSum<L, R, T, n, m> operator + (const GenericExpression<L, T, n, m>& lhs, const GenericExpression<R, T, n, m>& rhs) {
+    return GenericSum<L, R, T, n, m>(lhs.expression(), rhs.expression());
 }
 
-/*! \relates GenericMatrix
+/*! \relates GenericExpression
   оператор унарного минуса
-  \param rhs - матрица
-  \return матрица, противоположная к \a rhs
+  \param rhs - выражение
+  \return отложенное выражение, противоположное к \a rhs
 */
-template<typename T, int n, int m>
-const GenericMatrix<T, n, m> operator - (const GenericMatrix<T, n, m>& rhs) {
-    GenericMatrix<T, n, m> M = null;
-    return M -= rhs;
+template<typename E, typename T, int n, int m>
+MATRIX_CONSTEXPR const GenericNegation<E, T, n, m> operator - (const GenericExpression<E, T, n, m>& rhs) {
+    return GenericNegation<E, T, n, m>(rhs.expression());
 }
 
-/*! \relates GenericMatrix
+/*! \relates GenericExpression
   оператор вычитания
-  \param lhs - уменьшаемая матрица
-  \param rhs - вычитаемая матрица
-  \return разность матриц \a lhs и \a rhs
-*/
-template<typename T, int n, int m>
-const GenericMatrix<T, n, m> operator - (const GenericMatrix<T, n, m>& lhs, const GenericMatrix<T, n, m>& rhs) {
-    GenericMatrix<T, n, m> M = lhs;
-    return M -= rhs;
+  \param lhs - уменьшаемое
+  \param rhs - вычитаемое
+  \return отложенная разность \a lhs и \a rhs
+*/
+template<typename L, typename R, typename T, int n, int m>
+MATRIX_CONSTEXPR const GenericDifference<L, R, T, n, m> operator - (const GenericExpression<L, T, n, m>& lhs, const GenericExpression<R, T, n, m>& rhs) {
+    return GenericDifference<L, R, T, n, m>(lhs.expression(), rhs.expression());
 }
 
-/*! \relates GenericMatrix
-  оператор умножения матрицы и скаляра
+/*! \relates GenericExpression
+  оператор умножения выражения и скаляра
   \param lhs - матричный множитель
   \param rhs - скалярный множитель
-  \return произведение матрицы \a lhs и скаляра \a rhs
+  \return отложенное произведение \a lhs и скаляра \a rhs
 */
-template<typename T, int n, int m>
-const GenericMatrix<T, n, m> operator * (const GenericMatrix<T, n, m>& lhs, const T& rhs) {
-    GenericMatrix<T, n, m> M = lhs;
-    return M *= rhs;
+template<typename E, typename T, int n, int m>
+MATRIX_CONSTEXPR const GenericScaled<E, T, n, m> operator * (const GenericExpression<E, T, n, m>& lhs, const T& rhs) {
+    return GenericScaled<E, T, n, m>(lhs.expression(), rhs);
 }
 
-/*! \relates GenericMatrix
-  оператор умножения скаляра и матрицы
+/*! \relates GenericExpression
+  оператор умножения скаляра и выражения
   \param lhs - скалярный множитель
   \param rhs - матричный множитель
-  \return произведение скаляра \a lhs и матрицы \a rhs
+  \return отложенное произведение скаляра \a lhs и \a rhs
 */
-template<typename T, int n, int m>
-const GenericMatrix<T, n, m> operator * (const T& lhs, const GenericMatrix<T, n, m>& rhs) {
-    GenericMatrix<T, n, m> M = rhs;
-    return M *= lhs;
+template<typename E, typename T, int n, int m>
+MATRIX_CONSTEXPR const GenericScaled<E, T, n, m> operator * (const T& lhs, const GenericExpression<E, T, n, m>& rhs) {
+    return GenericScaled<E, T, n, m>(rhs.expression(), lhs);
 }
 
 /*! \relates GenericMatrix
@@ -269,13 +354,27 @@ const GenericMatrix<T, n, m> operator * (const T& lhs, const GenericMatrix<T, n,
   \param rhs - второй множитель, матрица \a k x \a m
   \return произведение матриц \a lhs и \a rhs, матрица \a n x \a m
 */
-template<typename T, int n, int k, int m>
-const GenericMatrix<T, n, m> operator * (const GenericMatrix<T, n, k>& lhs, const GenericMatrix<T, k, m>& rhs) {
+template<typename T, int n, int k, int m, typename S1, typename S2>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const GenericMatrix<T, n, k, S1>& lhs, const GenericMatrix<T, k, m, S2>& rhs) {
     GenericMatrix<T, n, m> M;
-    algorithms::mul(M.array(), lhs.array(), rhs.array(), n, k, m);
+    algorithms::fixed::Mul<n, k, m>::run(M.array(), lhs.array(), rhs.array());
     return M;
 }
 
+/*! \relates GenericExpression
+  оператор умножения выражений (выражения предварительно вычисляются)
+  \tparam n - количество строк первого множителя
+  \tparam k - количество столбцов первого множителя, равное количеству строк второго множителя
+  \tparam m - количество столбцов второго множителя
+  \param lhs - первый множитель, выражение \a n x \a k
+  \param rhs - второй множитель, выражение \a k x \a m
+  \return произведение \a lhs и \a rhs, матрица \a n x \a m
+*/
+template<typename L, typename R, typename T, int n, int k, int m>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const GenericExpression<L, T, n, k>& lhs, const GenericExpression<R, T, k, m>& rhs) {
+    return GenericMatrix<T, n, k>(lhs) * GenericMatrix<T, k, m>(rhs);
+}
+
 /*! \relates GenericMatrix
   конкатенация матриц
   \tparam n - количество строк в конкатенируемых матрицах
@@ -285,8 +384,8 @@ const GenericMatrix<T, n, m> operator * (const GenericMatrix<T, n, k>& lhs, cons
   \param rhs - матрица \a n x \a m2
   \return матрица \a n x (\a m1 + \a m2), полученная конкатенацией (по горизонтали) матриц \a lhs и \a rhs
 */
-template<typename T, int n, int m1, int m2>
-const GenericMatrix<T, n, m1 + m2> cat (const GenericMatrix<T, n, m1>& lhs, const GenericMatrix<T, n, m2>& rhs) {
+template<typename T, int n, int m1, int m2, typename S1, typename S2>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m1 + m2> cat (const GenericMatrix<T, n, m1, S1>& lhs, const GenericMatrix<T, n, m2, S2>& rhs) {
     GenericMatrix<T, n, m1 + m2> M;
     algorithms::cat(M.array(), lhs.array(), rhs.array(), n, m1, m2);
     return M;
@@ -301,8 +400,8 @@ const GenericMatrix<T, n, m1 + m2> cat (const GenericMatrix<T, n, m1>& lhs, cons
   \param j0 - левый столбец минора
   \return минор матрицы \a M, матрица \a n1 x \a m1
 */
-template<typename T, int n, int m, int n1, int m1>
-const GenericMatrix<T, n1, m1> minor (const GenericMatrix<T, n, m>& M, int i0, int j0) {
+template<typename T, int n, int m, int n1, int m1, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n1, m1> minor (const GenericMatrix<T, n, m, S>& M, int i0, int j0) {
     GenericMatrix<T, n1, m1> R;
     algorithms::minor(R.array(), M.array(), i0, j0, n, m, n1, m1);
     return R;
@@ -315,9 +414,9 @@ const GenericMatrix<T, n1, m1> minor (const GenericMatrix<T, n, m>& M, int i0, i
   \param M - матрица
   \return главный минор матрицы \a M, матрица \a n1 x \a m1
 */
-template<typename T, int n, int m, int n1, int m1>
-inline const GenericMatrix<T, n1, m1> minor (const GenericMatrix<T, n, m>& M) {
-    return minor<T, n, m, n1, m1>(M, 0, 0);
+template<typename T, int n, int m, int n1, int m1, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n1, m1> minor (const GenericMatrix<T, n, m, S>& M) {
+    return minor<T, n, m, n1, m1, S>(M, 0, 0);
 }
 
 /*! \relates GenericMatrix
@@ -329,8 +428,8 @@ inline const GenericMatrix<T, n1, m1> minor (const GenericMatrix<T, n, m>& M) {
   \param j0 - индекс левого стролбца матрицы в дополненной матрице
   \return матрица \a n1 x \a m1, содержащая матрицу \a M в качестве минора
 */
-template<typename T, int n, int m, int n1, int m1>
-const GenericMatrix<T, n1, m1> expand (const GenericMatrix<T, n, m>& M, int i0, int j0) {
+template<typename T, int n, int m, int n1, int m1, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n1, m1> expand (const GenericMatrix<T, n, m, S>& M, int i0, int j0) {
     GenericMatrix<T, n1, m1> R;
     algorithms::expand(R.array(), M.array(), i0, j0, n, m, n1, m1);
     return R;
@@ -343,9 +442,9 @@ const GenericMatrix<T, n1, m1> expand (const GenericMatrix<T, n, m>& M, int i0,
   \param M - матрица
   \return матрица \a n1 x \a m1, содержащая матрицу \a M в качестве главного минора
 */
-template<typename T, int n, int m, int n1, int m1>
-inline const GenericMatrix<T, n1, m1> expand (const GenericMatrix<T, n, m>& M) {
-    return expand<T, n, m, n1, m1>(M, 0, 0);
+template<typename T, int n, int m, int n1, int m1, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n1, m1> expand (const GenericMatrix<T, n, m, S>& M) {
+    return expand<T, n, m, n1, m1, S>(M, 0, 0);
 }
 
 /*! \relates GenericMatrix
@@ -353,11 +452,21 @@ inline const GenericMatrix<T, n1, m1> expand (const GenericMatrix<T, n, m>& M) {
   \param M - матрица
   \return сумма квадратов элементов матрицы \a M
 */
-template<typename T, int n, int m>
-T norm (const GenericMatrix<T, n, m>& M) {
+template<typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR T norm (const GenericMatrix<T, n, m, S>& M) {
     return algorithms::norm(M.array(), n, m);
 }
 
+/*! \relates GenericExpression
+  "норма" выражения
+  \param expression - выражение
+  \return сумма квадратов элементов \a expression
+*/
+template<typename E, typename T, int n, int m>
+MATRIX_CONSTEXPR T norm (const GenericExpression<E, T, n, m>& expression) {
+    return algorithms::eval_norm(expression.expression(), n, m);
+}
+
 /*! \relates GenericMatrix
   запись матрицы в поток вывода в бинарном виде
   \tparam Stream - тип потока вывода
@@ -365,12 +474,24 @@ T norm (const GenericMatrix<T, n, m>& M) {
   \param M - матрица
   \return поток вывода
 */
-template<typename T, int n, int m, typename Stream>
-Stream& operator << (Stream& stream, const GenericMatrix<T, n, m>& M) {
+template<typename T, int n, int m, typename S, typename Stream>
+Stream& operator << (Stream& stream, const GenericMatrix<T, n, m, S>& M) {
 //  return algorithms::pack(stream, M.array(), n, m);
     return algorithms::print(stream, M.array(), n, m);
 }
 
+/*! \relates GenericExpression
+  запись выражения в поток вывода
+  \tparam Stream - тип потока вывода
+  \param stream - поток вывода
+  \param expression - выражение
+  \return поток вывода
+*/
+template<typename E, typename T, int n, int m, typename Stream>
+Stream& operator << (Stream& stream, const GenericExpression<E, T, n, m>& expression) {
+    return stream << GenericMatrix<T, n, m>(expression);
+}
+
 /*! \relates GenericMatrix
   чтение матрицы из потока ввода в бинарном виде
   \tparam Stream - тип потока ввода
@@ -378,8 +499,8 @@ Stream& operator << (Stream& stream, const GenericMatrix<T, n, m>& M) {
   \param M - матрица
   \return поток ввода
 */
-template<typename T, int n, int m, typename Stream>
-Stream& operator >> (Stream& stream, GenericMatrix<T, n, m>& M) {
+template<typename T, int n, int m, typename S, typename Stream>
+Stream& operator >> (Stream& stream, GenericMatrix<T, n, m, S>& M) {
     return algorithms::unpack(stream, M.array(), n, m);
 }
 
@@ -0,0 +1,158 @@
+#ifndef _MATRIX_LDLT_H
+#define _MATRIX_LDLT_H
+
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include <ColumnMatrix.h>
+#include <identity_t.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class LDLT
+  \brief Шаблон LDLT - разложение M = L D L^T симметричной матрицы (без извлечения корней)
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк и столбцов матрицы
+
+  В отличие от Cholesky, существует и для невырожденных знаконеопределенных матриц с ненулевыми
+  ведущими минорами. Положительная определенность сообщается функцией positive(), вырожденность -
+  функцией singular(); для вырожденной матрицы solve(), inverse() и det() выбрасывают исключение
+  std::runtime_error (при USE_STD_EXCEPTIONS) либо возвращают нулевой результат.
+*/
+template<typename T, int n>
+class LDLT {
+    SquareMatrix<T, n> m_LD;
+    bool m_singular;
+
+    bool check (void) const {
+#if USE_STD_EXCEPTIONS
+        if (m_singular) {
+            throw std::runtime_error("matrix is singular");
+        }
+#endif
+        return !m_singular;
+    }
+public:
+/*!
+  конструктор разложения
+  \param M - симметричная матрица (используется нижний треугольник)
+*/
+    explicit LDLT (const SquareMatrix<T, n>& M) : m_LD(M) {
+        m_singular = !algorithms::ldlt(m_LD.array(), n);
+    }
+
+/*!
+  признак вырожденности разложения
+  \return \a true, если один из элементов D не превышает по модулю precision
+*/
+    bool singular (void) const {
+        return m_singular;
+    }
+
+/*!
+  признак положительной определенности матрицы
+  \return \a true, если все элементы D положительны
+*/
+    bool positive (void) const {
+        if (m_singular) {
+            return false;
+        }
+        for (int i = 0; i < n; ++i) {
+            if (m_LD[i][i] <= 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+/*!
+  определитель матрицы
+  \return произведение элементов D
+*/
+    T det (void) const {
+        if (!check()) {
+            return 0;
+        }
+        T D = 1;
+        for (int i = 0; i < n; ++i) {
+            D *= m_LD[i][i];
+        }
+        return D;
+    }
+
+/*!
+  логарифм определителя положительно определенной матрицы
+  \return сумма логарифмов элементов D
+*/
+    T logdet (void) const {
+#if USE_STD_EXCEPTIONS
+        if (!positive()) {
+            throw std::runtime_error("matrix is not positive definite");
+        }
+#endif
+        T S = 0;
+        for (int i = 0; i < n; ++i) {
+            S += std::log(m_LD[i][i]);
+        }
+        return S;
+    }
+
+/*!
+  решение системы M x = b
+  \param b - правая часть
+  \return решение системы
+*/
+    ColumnMatrix<T, n> solve (const ColumnMatrix<T, n>& b) const {
+        ColumnMatrix<T, n> x = b;
+        solve(x.array(), 1);
+        return x;
+    }
+
+/*!
+  решение системы M X = B с несколькими правыми частями
+  \tparam k - количество правых частей
+  \param B - правые части, матрица \a n x \a k
+  \return решение системы, матрица \a n x \a k
+*/
+    template<int k>
+    GenericMatrix<T, n, k> solve (const GenericMatrix<T, n, k>& B) const {
+        GenericMatrix<T, n, k> X = B;
+        solve(X.array(), k);
+        return X;
+    }
+
+/*!
+  обратная матрица
+  \return матрица, обратная к M
+*/
+    SquareMatrix<T, n> inverse (void) const {
+        SquareMatrix<T, n> E = identity;
+        solve(E.array(), n);
+        return E;
+    }
+
+/*!
+  решение системы на месте
+  \param array - правые части, матрица \a n x \a k, заменяемая на решение (нулевая для вырожденной M)
+  \param k - количество правых частей
+*/
+    void solve (T* array, int k) const {
+        if (!check()) {
+            algorithms::null(array, n, k);
+            return;
+        }
+        algorithms::ldlt_solve(m_LD.array(), array, n, k);
+    }
+
+/*!
+  множители разложения
+  \return матрица, содержащая L ниже диагонали (диагональ L единичная) и D на диагонали
+*/
+    const SquareMatrix<T, n>& matrix (void) const {
+        return m_LD;
+    }
+};
+
+}
+
+#endif
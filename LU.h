@@ -0,0 +1,110 @@
+#ifndef _MATRIX_LU_H
+#define _MATRIX_LU_H
+
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include <ColumnMatrix.h>
+#include <identity_t.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class LU
+  \brief Шаблон LU - LU-разложение квадратной матрицы с частичным выбором ведущего элемента
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк и столбцов матрицы
+
+  Разложение вычисляется один раз в конструкторе и затем используется для вычисления определителя,
+  обратной матрицы и решения систем с любым количеством правых частей.
+*/
+template<typename T, int n>
+class LU {
+    SquareMatrix<T, n> m_lu;
+    int m_pivot[n];
+    T m_det;
+    bool m_singular;
+public:
+/*!
+  конструктор разложения
+  \param M - раскладываемая матрица
+*/
+    explicit LU (const SquareMatrix<T, n>& M) : m_lu(M) {
+        m_det = algorithms::lu(m_lu.array(), m_pivot, n, &m_singular);
+    }
+
+/*!
+  признак вырожденности матрицы
+  \return \a true, если один из ведущих элементов не превышает precision
+*/
+    bool singular (void) const {
+        return m_singular;
+    }
+
+/*!
+  определитель матрицы
+  \return определитель (0 для вырожденной матрицы; может обратиться в 0 и для невырожденной
+  матрицы большого размера, вырожденность проверяется функцией singular)
+*/
+    T det (void) const {
+        return m_det;
+    }
+
+/*!
+  решение системы M x = b
+  \param b - правая часть
+  \return решение системы (нулевая матрица-столбец в случае вырожденности M)
+*/
+    ColumnMatrix<T, n> solve (const ColumnMatrix<T, n>& b) const {
+        ColumnMatrix<T, n> x = b;
+        solve(x.array(), 1);
+        return x;
+    }
+
+/*!
+  решение системы M X = B с несколькими правыми частями
+  \tparam k - количество правых частей
+  \param B - правые части, матрица \a n x \a k
+  \return решение системы, матрица \a n x \a k (нулевая в случае вырожденности M)
+*/
+    template<int k>
+    GenericMatrix<T, n, k> solve (const GenericMatrix<T, n, k>& B) const {
+        GenericMatrix<T, n, k> X = B;
+        solve(X.array(), k);
+        return X;
+    }
+
+/*!
+  обратная матрица
+  \return матрица, обратная к M (нулевая матрица в случае вырожденности M)
+*/
+    SquareMatrix<T, n> inverse (void) const {
+        SquareMatrix<T, n> E = identity;
+        solve(E.array(), n);
+        return E;
+    }
+
+/*!
+  решение системы на месте
+  \param array - правые части, матрица \a n x \a k, заменяемая на решение
+  \param k - количество правых частей
+*/
+    void solve (T* array, int k) const {
+        if (singular()) {
+            algorithms::null(array, n, k);
+            return;
+        }
+        algorithms::lu_solve(m_lu.array(), m_pivot, array, n, k);
+    }
+
+/*!
+  совмещенные множители разложения
+  \return матрица, содержащая L ниже диагонали (диагональ L единичная) и U на диагонали и выше
+*/
+    const SquareMatrix<T, n>& matrix (void) const {
+        return m_lu;
+    }
+};
+
+}
+
+#endif
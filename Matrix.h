@@ -7,15 +7,32 @@
 
 #include <null_t.h>
 #include <identity_t.h>
+#include <GenericExpression.h>
 #include <GenericMatrix.h>
+#include <BlockView.h>
 #include <SquareMatrix.h>
+#include <LU.h>
+#include <Cholesky.h>
+#include <LDLT.h>
+#include <Woodbury.h>
 #include <ColumnMatrix.h>
 #include <RowMatrix.h>
 #include <ScalarMatrix.h>
+#include <SymmetricMatrix.h>
+#include <PermutationMatrix.h>
+#include <DiagonalMatrix.h>
+#include <MatrixBatch.h>
+#include <MatrixFile.h>
+#include <MatrixStream.h>
+#include <DynamicMatrix.h>
+#include <TransposedView.h>
 #include <transpose.h>
 #include <dot.h>
 #include <conjugate.h>
 #include <sqr.h>
+#include <rank_update.h>
+#include <solve.h>
+#include <format.h>
 #include <precision.h>
 
 #endif
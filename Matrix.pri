@@ -1,17 +1,42 @@
 INCLUDEPATH += $$PWD
 DEPENDPATH += $$PWD
+CONFIG += thread
 
 HEADERS += $$PWD/algorithms.h
+HEADERS += $$PWD/aligned.h
+HEADERS += $$PWD/arena.h
+HEADERS += $$PWD/BlockView.h
+HEADERS += $$PWD/Cholesky.h
 HEADERS += $$PWD/ColumnMatrix.h
 HEADERS += $$PWD/conjugate.h
+HEADERS += $$PWD/constexpr.h
+HEADERS += $$PWD/DiagonalMatrix.h
 HEADERS += $$PWD/dot.h
+HEADERS += $$PWD/DynamicMatrix.h
+HEADERS += $$PWD/fixed.h
+HEADERS += $$PWD/format.h
+HEADERS += $$PWD/GenericExpression.h
 HEADERS += $$PWD/GenericMatrix.h
 HEADERS += $$PWD/identity_t.h
+HEADERS += $$PWD/LDLT.h
+HEADERS += $$PWD/LU.h
 HEADERS += $$PWD/Matrix.h
+HEADERS += $$PWD/MatrixBatch.h
+HEADERS += $$PWD/MatrixFile.h
+HEADERS += $$PWD/MatrixStream.h
 HEADERS += $$PWD/null_t.h
+HEADERS += $$PWD/parallel.h
+HEADERS += $$PWD/PermutationMatrix.h
 HEADERS += $$PWD/precision.h
+HEADERS += $$PWD/rank_update.h
 HEADERS += $$PWD/RowMatrix.h
+HEADERS += $$PWD/simd.h
+HEADERS += $$PWD/solve.h
 HEADERS += $$PWD/ScalarMatrix.h
 HEADERS += $$PWD/SquareMatrix.h
 HEADERS += $$PWD/sqr.h
+HEADERS += $$PWD/storage.h
+HEADERS += $$PWD/SymmetricMatrix.h
 HEADERS += $$PWD/transpose.h
+HEADERS += $$PWD/TransposedView.h
+HEADERS += $$PWD/Woodbury.h
@@ -0,0 +1,610 @@
+#ifndef _MATRIX_MATRIXBATCH_H
+#define _MATRIX_MATRIXBATCH_H
+
+#include <utility>
+#include <vector>
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include "algorithms.h"
+#include "aligned.h"
+
+namespace Matrix {
+
+namespace algorithms {
+
+/*! \namespace batch
+  Ядра операций над пакетами матриц в виде структуры массивов: элемент (i, j) всех матриц пакета
+  хранится подряд в массиве длины \a size, внутренние циклы идут по матрицам пакета и векторизуются
+*/
+namespace batch {
+
+template<typename T>
+void mul (T* dst, const T* lhs, const T* rhs, int n, int k, int m, int size) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            T* _dst = dst + (i * m + j) * size;
+            null(_dst, 1, size);
+            for (int l = 0; l < k; ++l) {
+                const T* _lhs = lhs + (i * k + l) * size;
+                const T* _rhs = rhs + (l * m + j) * size;
+                for (int b = 0; b < size; ++b) {
+                    _dst[b] += _lhs[b] * _rhs[b];
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+void transpose (T* dst, const T* src, int n, int m, int size) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            cp(dst + (j * n + i) * size, src + (i * m + j) * size, size);
+        }
+    }
+}
+
+template<typename T>
+void conjugate (T* dst, const T* M, const T* C, int n, int m, int size) {
+    Scratch<T> CM(n * m * size);
+    mul(CM.data(), C, M, n, m, m, size);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            T* _dst = dst + (i * n + j) * size;
+            null(_dst, 1, size);
+            for (int l = 0; l < m; ++l) {
+                const T* _lhs = CM.data() + (i * m + l) * size;
+                const T* _rhs = C + (j * m + l) * size;
+                for (int b = 0; b < size; ++b) {
+                    _dst[b] += _lhs[b] * _rhs[b];
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+void conjugate_shared (T* dst, const T* M, const T* C, int n, int m, int size) {
+    Scratch<T> CM(n * m * size);
+    null(CM.data(), n * m, size);
+    for (int i = 0; i < n; ++i) {
+        for (int p = 0; p < m; ++p) {
+            T* _dst = CM.data() + (i * m + p) * size;
+            for (int l = 0; l < m; ++l) {
+                T c = C[i * m + l];
+                const T* _rhs = M + (l * m + p) * size;
+                for (int b = 0; b < size; ++b) {
+                    _dst[b] += c * _rhs[b];
+                }
+            }
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            T* _dst = dst + (i * n + j) * size;
+            null(_dst, 1, size);
+            for (int p = 0; p < m; ++p) {
+                T c = C[j * m + p];
+                const T* _lhs = CM.data() + (i * m + p) * size;
+                for (int b = 0; b < size; ++b) {
+                    _dst[b] += _lhs[b] * c;
+                }
+            }
+        }
+    }
+}
+
+/*!
+  перестановка строк \a j и \a row[b] каждой матрицы \a b пакета без ветвлений по матрицам
+  (при row[b] == j строка остается на месте)
+*/
+template<typename T>
+void swap_rows (T* array, const int* row, int j, int n, int size) {
+    for (int k = 0; k < n; ++k) {
+        T* _j = array + (j * n + k) * size;
+        for (int b = 0; b < size; ++b) {
+            T* _p = array + (row[b] * n + k) * size + b;
+            T swap = *_p;
+            *_p = _j[b];
+            _j[b] = swap;
+        }
+    }
+}
+
+/*!
+  выбор ведущего элемента столбца \a j для каждой матрицы пакета и перестановка строк
+  \param array - пакет матриц \a n x \a n, приводимых к треугольному (диагональному) виду
+  \param inverse - пакет матриц, над которыми выполняются те же перестановки строк (может быть 0)
+  \param D - определители, меняющие знак при перестановке строк и обнуляемые для вырожденных матриц
+  \param pivot - ведущие элементы (1 для вырожденных матриц)
+
+  Максимум модуля и его строка выбираются для всех матриц пакета одновременно, условия заменены
+  выбором значений, поэтому внутренние циклы по матрицам пакета не ветвятся и векторизуются.
+*/
+template<typename T>
+void pivot (T* array, T* inverse, T* D, T* pivot, int j, int n, int size) {
+    Scratch<int> row(size);
+    const T* _col = array + (j * n + j) * size;
+    for (int b = 0; b < size; ++b) {
+        pivot[b] = algorithms::abs(_col[b]);
+        row[b] = j;
+    }
+    for (int i = j + 1; i < n; ++i) {
+        _col = array + (i * n + j) * size;
+        for (int b = 0; b < size; ++b) {
+            T cell = algorithms::abs(_col[b]);
+            bool greater = cell > pivot[b];
+            pivot[b] = greater ? cell : pivot[b];
+            row[b] = greater ? i : row[b];
+        }
+    }
+    swap_rows(array, row.data(), j, n, size);
+    if (inverse) {
+        swap_rows(inverse, row.data(), j, n, size);
+    }
+    _col = array + (j * n + j) * size;
+    for (int b = 0; b < size; ++b) {
+        bool singular = pivot[b] <= precision<T>();
+        T sign = row[b] != j ? -1 : 1;
+        pivot[b] = singular ? 1 : _col[b];
+        D[b] = singular ? 0 : D[b] * sign * _col[b];
+    }
+}
+
+template<typename T>
+void det (T* D, T* array, int n, int size) {
+    Scratch<T> P(size);
+    Scratch<T> F(size);
+    for (int b = 0; b < size; ++b) {
+        D[b] = 1;
+    }
+    for (int j = 0; j < n; ++j) {
+        pivot(array, (T*) 0, D, P.data(), j, n, size);
+        for (int i = j + 1; i < n; ++i) {
+            const T* _col = array + (i * n + j) * size;
+            for (int b = 0; b < size; ++b) {
+                F[b] = _col[b] / P[b];
+            }
+            for (int k = j + 1; k < n; ++k) {
+                T* _dst = array + (i * n + k) * size;
+                const T* _src = array + (j * n + k) * size;
+                for (int b = 0; b < size; ++b) {
+                    _dst[b] -= F[b] * _src[b];
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+void gauss (T* D, T* inverse, T* array, int n, int size) {
+    Scratch<T> P(size);
+    Scratch<T> F(size);
+    null(inverse, n * n, size);
+    for (int i = 0; i < n; ++i) {
+        T* _dst = inverse + (i * n + i) * size;
+        for (int b = 0; b < size; ++b) {
+            _dst[b] = 1;
+        }
+    }
+    for (int b = 0; b < size; ++b) {
+        D[b] = 1;
+    }
+    for (int j = 0; j < n; ++j) {
+        pivot(array, inverse, D, P.data(), j, n, size);
+        for (int b = 0; b < size; ++b) {
+            F[b] = 1 / P[b];
+        }
+        for (int k = 0; k < n; ++k) {
+            T* _a = array + (j * n + k) * size;
+            T* _e = inverse + (j * n + k) * size;
+            for (int b = 0; b < size; ++b) {
+                _a[b] *= F[b];
+                _e[b] *= F[b];
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            if (i == j) {
+                continue;
+            }
+            cp(F.data(), array + (i * n + j) * size, size);
+            for (int k = 0; k < n; ++k) {
+                T* _a = array + (i * n + k) * size;
+                T* _e = inverse + (i * n + k) * size;
+                const T* _aj = array + (j * n + k) * size;
+                const T* _ej = inverse + (j * n + k) * size;
+                for (int b = 0; b < size; ++b) {
+                    _a[b] -= F[b] * _aj[b];
+                    _e[b] -= F[b] * _ej[b];
+                }
+            }
+        }
+    }
+    for (int b = 0; b < size; ++b) {
+        if (D[b] == 0) {
+            for (int k = 0; k < n * n; ++k) {
+                inverse[k * size + b] = 0;
+            }
+        }
+    }
+}
+
+}
+
+}
+
+/*! \class MatrixBatch
+  \brief Шаблон MatrixBatch - пакет однотипных матриц, хранимый в виде структуры массивов
+  \tparam T - тип элементов матриц
+  \tparam n - количество строк матриц
+  \tparam m - количество столбцов матриц
+
+  Элемент (i, j) всех матриц пакета хранится подряд в массиве, выровненном по MEMORY_ALIGNMENT,
+  поэтому операции над пакетом векторизуются по матрицам пакета. Количество матриц выравнивается вверх до кратного \a alignment, дополнительные
+  матрицы нулевые и в результатах не участвуют.
+*/
+template<typename T, int n, int m>
+class MatrixBatch {
+public:
+/*! \typedef ElementType
+  тип элементов матриц
+*/
+    typedef T ElementType;
+
+/*!
+  количество строк матриц
+*/
+    static const int rows = n;
+
+/*!
+  количество столбцов матриц
+*/
+    static const int columns = m;
+
+/*!
+  кратность, до которой выравнивается количество матриц в массиве элементов (не меньше 8 и такая,
+  что массив элементов (i, j) всех матриц начинается с адреса, выровненного по MEMORY_ALIGNMENT)
+*/
+    static const int alignment = (int) (MEMORY_ALIGNMENT / sizeof(T)) > 8 ? (int) (MEMORY_ALIGNMENT / sizeof(T)) : 8;
+private:
+    int m_size;
+    int m_stride;
+    T* m_array;
+public:
+/*!
+  конструктор пакета нулевых матриц
+  \param size - количество матриц в пакете
+*/
+    explicit MatrixBatch (int size = 0) : m_size(size), m_stride((size + alignment - 1) / alignment * alignment), m_array(algorithms::allocate<T>(n * m * m_stride)) {
+        algorithms::null(m_array, n * m, m_stride);
+    }
+
+/*!
+  конструктор копирования
+  \param other - копируемый пакет
+*/
+    MatrixBatch (const MatrixBatch& other) : m_size(other.m_size), m_stride(other.m_stride), m_array(algorithms::allocate<T>(n * m * m_stride)) {
+        algorithms::cp(m_array, other.m_array, n * m * m_stride);
+    }
+
+/*!
+  конструктор перемещения
+  \param other - перемещаемый пакет (становится пустым)
+*/
+    MatrixBatch (MatrixBatch&& other) noexcept : m_size(other.m_size), m_stride(other.m_stride), m_array(other.m_array) {
+        other.m_size = 0;
+        other.m_stride = 0;
+        other.m_array = nullptr;
+    }
+
+/*!
+  деструктор
+*/
+    ~MatrixBatch (void) {
+        algorithms::deallocate(m_array);
+    }
+
+/*!
+  оператор копирования (память перераспределяется только при изменении количества матриц)
+  \param other - копируемый пакет
+*/
+    MatrixBatch& operator = (const MatrixBatch& other) {
+        if (this != &other) {
+            if (other.m_stride != m_stride) {
+                algorithms::deallocate(m_array);
+                m_array = nullptr;
+                m_size = 0;
+                m_stride = 0;
+                m_array = algorithms::allocate<T>(n * m * other.m_stride);
+                m_stride = other.m_stride;
+            }
+            m_size = other.m_size;
+            algorithms::cp(m_array, other.m_array, n * m * m_stride);
+        }
+        return *this;
+    }
+
+/*!
+  оператор перемещения
+  \param other - перемещаемый пакет
+*/
+    MatrixBatch& operator = (MatrixBatch&& other) noexcept {
+        std::swap(m_size, other.m_size);
+        std::swap(m_stride, other.m_stride);
+        std::swap(m_array, other.m_array);
+        return *this;
+    }
+
+/*!
+  количество матриц в пакете
+*/
+    int size (void) const {
+        return m_size;
+    }
+
+/*!
+  шаг между элементами (i, j) и (i, j + 1) в массиве элементов
+*/
+    int stride (void) const {
+        return m_stride;
+    }
+
+/*!
+  чтение матрицы из пакета
+  \param index - индекс матрицы в пакете
+  \return копия матрицы
+*/
+    GenericMatrix<T, n, m> get (int index) const {
+        GenericMatrix<T, n, m> M;
+        T* _dst = M.array();
+        const T* _src = array() + index;
+        int cnt = n * m;
+        while (cnt--) {
+            *_dst++ = *_src;
+            _src += m_stride;
+        }
+        return M;
+    }
+
+/*!
+  запись матрицы в пакет
+  \param index - индекс матрицы в пакете
+  \param M - записываемая матрица
+*/
+    void set (int index, const GenericMatrix<T, n, m>& M) {
+        const T* _src = M.array();
+        T* _dst = array() + index;
+        int cnt = n * m;
+        while (cnt--) {
+            *_dst = *_src++;
+            _dst += m_stride;
+        }
+    }
+
+/*!
+  оператор умножения на скаляр
+  \param scalar - скалярный множитель
+  \return пакет, все матрицы которого умножены на \a scalar
+*/
+    MatrixBatch& operator *= (const T& scalar) {
+        algorithms::mul(array(), scalar, n * m, m_stride);
+        return *this;
+    }
+
+/*!
+  оператор прибавления другого пакета
+  \param other - пакет того же размера
+  \return пакет, увеличенный на \a other
+*/
+    MatrixBatch& operator += (const MatrixBatch& other) {
+#if USE_STD_EXCEPTIONS
+        if (other.m_size != m_size) {
+            throw std::runtime_error("matrix batch size mismatch");
+        }
+#endif
+        algorithms::add(array(), other.array(), n * m, m_stride);
+        return *this;
+    }
+
+/*!
+  оператор вычитания другого пакета
+  \param other - пакет того же размера
+  \return пакет, уменьшенный на \a other
+*/
+    MatrixBatch& operator -= (const MatrixBatch& other) {
+#if USE_STD_EXCEPTIONS
+        if (other.m_size != m_size) {
+            throw std::runtime_error("matrix batch size mismatch");
+        }
+#endif
+        algorithms::sub(array(), other.array(), n * m, m_stride);
+        return *this;
+    }
+
+/*!
+  массив элементов (i, j) всех матриц пакета
+  \param i - индекс строки
+  \param j - индекс столбца
+  \return константный указатель на \a stride() элементов
+*/
+    const T* array (int i, int j) const {
+        return array() + (i * m + j) * m_stride;
+    }
+
+/*!
+  массив элементов (i, j) всех матриц пакета
+  \param i - индекс строки
+  \param j - индекс столбца
+  \return указатель на \a stride() элементов
+*/
+    T* array (int i, int j) {
+        return array() + (i * m + j) * m_stride;
+    }
+
+/*!
+  массив элементов пакета
+  \return константный указатель на начало массива элементов пакета
+*/
+    const T* array (void) const {
+        return m_array;
+    }
+
+/*!
+  массив элементов пакета
+  \return указатель на начало массива элементов пакета
+*/
+    T* array (void) {
+        return m_array;
+    }
+};
+
+/*! \relates MatrixBatch
+  оператор сложения пакетов
+  \param lhs - первое слагаемое
+  \param rhs - второе слагаемое
+  \return пакет попарных сумм матриц \a lhs и \a rhs
+*/
+template<typename T, int n, int m>
+MatrixBatch<T, n, m> operator + (const MatrixBatch<T, n, m>& lhs, const MatrixBatch<T, n, m>& rhs) {
+    MatrixBatch<T, n, m> B = lhs;
+    B += rhs;
+    return B;
+}
+
+/*! \relates MatrixBatch
+  оператор вычитания пакетов
+  \param lhs - уменьшаемое
+  \param rhs - вычитаемое
+  \return пакет попарных разностей матриц \a lhs и \a rhs
+*/
+template<typename T, int n, int m>
+MatrixBatch<T, n, m> operator - (const MatrixBatch<T, n, m>& lhs, const MatrixBatch<T, n, m>& rhs) {
+    MatrixBatch<T, n, m> B = lhs;
+    B -= rhs;
+    return B;
+}
+
+/*! \relates MatrixBatch
+  оператор умножения пакета и скаляра
+  \param lhs - пакет
+  \param rhs - скалярный множитель
+  \return пакет матриц \a lhs, умноженных на \a rhs
+*/
+template<typename T, int n, int m>
+MatrixBatch<T, n, m> operator * (const MatrixBatch<T, n, m>& lhs, const T& rhs) {
+    MatrixBatch<T, n, m> B = lhs;
+    B *= rhs;
+    return B;
+}
+
+/*! \relates MatrixBatch
+  оператор умножения скаляра и пакета
+  \param lhs - скалярный множитель
+  \param rhs - пакет
+  \return пакет матриц \a rhs, умноженных на \a lhs
+*/
+template<typename T, int n, int m>
+MatrixBatch<T, n, m> operator * (const T& lhs, const MatrixBatch<T, n, m>& rhs) {
+    MatrixBatch<T, n, m> B = rhs;
+    B *= lhs;
+    return B;
+}
+
+/*! \relates MatrixBatch
+  оператор попарного умножения матриц пакетов
+  \param lhs - пакет матриц \a n x \a k
+  \param rhs - пакет матриц \a k x \a m того же размера
+  \return пакет попарных произведений, матрицы \a n x \a m
+*/
+template<typename T, int n, int k, int m>
+MatrixBatch<T, n, m> operator * (const MatrixBatch<T, n, k>& lhs, const MatrixBatch<T, k, m>& rhs) {
+#if USE_STD_EXCEPTIONS
+    if (lhs.size() != rhs.size()) {
+        throw std::runtime_error("matrix batch size mismatch");
+    }
+#endif
+    MatrixBatch<T, n, m> B(lhs.size());
+    algorithms::batch::mul(B.array(), lhs.array(), rhs.array(), n, k, m, B.stride());
+    return B;
+}
+
+/*! \relates MatrixBatch
+  транспонирование матриц пакета
+  \param B - пакет матриц \a n x \a m
+  \return пакет транспонированных матриц \a m x \a n
+*/
+template<typename T, int n, int m>
+MatrixBatch<T, m, n> transpose (const MatrixBatch<T, n, m>& B) {
+    MatrixBatch<T, m, n> R(B.size());
+    algorithms::batch::transpose(R.array(), B.array(), n, m, R.stride());
+    return R;
+}
+
+/*! \relates MatrixBatch
+  вычисление определителей матриц пакета
+  \param B - пакет квадратных матриц
+  \return определители матриц \a B
+*/
+template<typename T, int n>
+std::vector<T> det (const MatrixBatch<T, n, n>& B) {
+    algorithms::Scratch<T> C(n * n * B.stride());
+    algorithms::cp(C.data(), B.array(), n * n * B.stride());
+    std::vector<T> D(B.stride());
+    algorithms::batch::det(D.data(), C.data(), n, B.stride());
+    D.resize(B.size());
+    return D;
+}
+
+/*! \relates MatrixBatch
+  вычисление обратных матриц пакета
+  \param B - пакет квадратных матриц
+  \return пакет матриц, обратных к матрицам \a B (нулевые матрицы для вырожденных)
+*/
+template<typename T, int n>
+MatrixBatch<T, n, n> inverse (const MatrixBatch<T, n, n>& B) {
+    algorithms::Scratch<T> C(n * n * B.stride());
+    algorithms::cp(C.data(), B.array(), n * n * B.stride());
+    MatrixBatch<T, n, n> R(B.size());
+    algorithms::Scratch<T> D(B.stride());
+    algorithms::batch::gauss(D.data(), R.array(), C.data(), n, B.stride());
+    return R;
+}
+
+/*! \relates MatrixBatch
+  попарное сопряжение матриц пакетов
+  \tparam n - количество строк и столбцов в результирующих матрицах
+  \tparam m - количество строк и столбцов в исходных матрицах
+  \param M - пакет сопрягаемых матриц \a m x \a m
+  \param C - пакет сопрягающих матриц \a n x \a m
+  \return пакет матриц \a M, умноженных слева на \a C и справа на транспонированные \a C
+*/
+template<typename T, int n, int m>
+MatrixBatch<T, n, n> conjugate (const MatrixBatch<T, m, m>& M, const MatrixBatch<T, n, m>& C) {
+#if USE_STD_EXCEPTIONS
+    if (M.size() != C.size()) {
+        throw std::runtime_error("matrix batch size mismatch");
+    }
+#endif
+    MatrixBatch<T, n, n> R(M.size());
+    algorithms::batch::conjugate(R.array(), M.array(), C.array(), n, m, R.stride());
+    return R;
+}
+
+/*! \relates MatrixBatch
+  сопряжение всех матриц пакета одной матрицей
+  \tparam n - количество строк и столбцов в результирующих матрицах
+  \tparam m - количество строк и столбцов в исходных матрицах
+  \param M - пакет сопрягаемых матриц \a m x \a m
+  \param C - сопрягающая матрица \a n x \a m
+  \return пакет матриц \a M, умноженных слева на \a C и справа на транспонированную \a C
+*/
+template<typename T, int n, int m>
+MatrixBatch<T, n, n> conjugate (const MatrixBatch<T, m, m>& M, const GenericMatrix<T, n, m>& C) {
+    MatrixBatch<T, n, n> R(M.size());
+    algorithms::batch::conjugate_shared(R.array(), M.array(), C.array(), n, m, R.stride());
+    return R;
+}
+
+}
+
+#endif
@@ -0,0 +1,432 @@
+#ifndef _MATRIX_MATRIXFILE_H
+#define _MATRIX_MATRIXFILE_H
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <GenericMatrix.h>
+#include "algorithms.h"
+#include "aligned.h"
+#include "storage.h"
+
+/*! \def USE_MMAP
+  Отображение файлов матриц в память (POSIX mmap). Без него MappedMatrixFile читает файл целиком
+  в выровненный буфер.
+*/
+
+#ifndef USE_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define USE_MMAP 1
+#else
+#define USE_MMAP 0
+#endif
+#endif
+
+#if USE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*! \def MATRIX_FILE_VERSION
+  Версия формата файла матриц
+*/
+
+#define MATRIX_FILE_VERSION 1
+
+namespace Matrix {
+
+/*! \class MatrixFileHeader
+  \brief Заголовок бинарного файла матриц (64 байта)
+
+  За заголовком с отступа \a offset от начала файла следуют \a count записей по \a rows * \a columns
+  элементов без промежутков, в порядке строк и в порядке байтов записавшей машины.
+*/
+struct MatrixFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endian;
+    std::uint32_t type;
+    std::uint32_t element_size;
+    std::uint32_t rows;
+    std::uint32_t columns;
+    std::uint32_t alignment;
+    std::uint32_t reserved;
+    std::uint64_t count;
+    std::uint64_t offset;
+    char padding[8];
+};
+
+static_assert(sizeof(MatrixFileHeader) == 64, "matrix file header must be 64 bytes");
+
+namespace algorithms {
+
+/*!
+  код типа элементов в заголовке файла матриц
+  \tparam T - числовой тип
+  \return ненулевой код типа
+*/
+template<typename T>
+inline std::uint32_t type_code (void);
+
+template<>
+inline std::uint32_t type_code<int> (void) {
+    return 1;
+}
+
+template<>
+inline std::uint32_t type_code<float> (void) {
+    return 2;
+}
+
+template<>
+inline std::uint32_t type_code<double> (void) {
+    return 3;
+}
+
+template<>
+inline std::uint32_t type_code<long double> (void) {
+    return 4;
+}
+
+/*!
+  ошибка чтения или записи файла матриц
+  \param message - текст исключения std::runtime_error (при USE_STD_EXCEPTIONS)
+  \return \a false
+*/
+inline bool file_error (const char* message) {
+#if USE_STD_EXCEPTIONS
+    throw std::runtime_error(message);
+#else
+    (void) message;
+#endif
+    return false;
+}
+
+/*!
+  заполнение заголовка файла матриц
+  \param alignment - выравнивание (в байтах) начала записей относительно начала файла
+  (не меньше alignof(T), меньшие значения, в том числе 0, заменяются на alignof(T))
+*/
+template<typename T, int n, int m>
+MatrixFileHeader file_header (std::uint64_t count, std::uint32_t alignment) {
+    if (alignment < alignof(T)) {
+        alignment = alignof(T);
+    }
+    MatrixFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "MATRIXF", 8);
+    header.version = MATRIX_FILE_VERSION;
+    header.endian = 0x01020304;
+    header.type = type_code<T>();
+    header.element_size = sizeof(T);
+    header.rows = n;
+    header.columns = m;
+    header.alignment = alignment;
+    header.count = count;
+    header.offset = (sizeof(MatrixFileHeader) + alignment - 1) / alignment * alignment;
+    return header;
+}
+
+/*!
+  проверка заголовка потока матриц (без сверки с размером файла)
+  \param header - прочитанный заголовок
+  \return \a true, если заголовок соответствует матрицам \a n x \a m типа \a T
+*/
+template<typename T, int n, int m>
+bool check_header (const MatrixFileHeader& header) {
+    if (std::memcmp(header.magic, "MATRIXF", 8)) {
+        return file_error("not a matrix file");
+    }
+    if (header.version != MATRIX_FILE_VERSION || header.endian != 0x01020304) {
+        return file_error("unsupported matrix file version or byte order");
+    }
+    if (header.type != type_code<T>() || header.element_size != sizeof(T) || header.rows != (std::uint32_t) n || header.columns != (std::uint32_t) m) {
+        return file_error("matrix file type or size mismatch");
+    }
+    if (header.offset < sizeof(MatrixFileHeader)) {
+        return file_error("matrix file header corrupted");
+    }
+    return true;
+}
+
+/*!
+  проверка заголовка файла матриц
+  \param header - прочитанный заголовок
+  \param size - размер файла в байтах
+  \return \a true, если заголовок соответствует матрицам \a n x \a m типа \a T и размеру файла
+*/
+template<typename T, int n, int m>
+bool check_header (const MatrixFileHeader& header, std::uint64_t size) {
+    if (size < sizeof(MatrixFileHeader)) {
+        return file_error("not a matrix file");
+    }
+    if (!check_header<T, n, m>(header)) {
+        return false;
+    }
+    if (header.offset % alignof(T) || header.offset > size || (size - header.offset) / (sizeof(T) * n * m) < header.count) {
+        return file_error("matrix file truncated");
+    }
+    return true;
+}
+
+}
+
+/*! \class MatrixFileWriter
+  \brief Шаблон MatrixFileWriter - запись массива матриц фиксированного размера в бинарный файл
+  \tparam T - тип элементов матриц
+  \tparam n - количество строк матриц
+  \tparam m - количество столбцов матриц
+
+  Количество записей сохраняется в заголовке при закрытии файла.
+*/
+template<typename T, int n, int m>
+class MatrixFileWriter {
+    std::FILE* m_file;
+    std::uint64_t m_count;
+    std::uint32_t m_alignment;
+public:
+/*!
+  \param path - путь к файлу
+  \param alignment - выравнивание (в байтах) начала записей относительно начала файла
+*/
+    explicit MatrixFileWriter (const char* path, std::uint32_t alignment = MEMORY_ALIGNMENT) : m_file(std::fopen(path, "wb")), m_count(0), m_alignment(alignment) {
+        if (!m_file) {
+            algorithms::file_error("can't open matrix file");
+            return;
+        }
+        MatrixFileHeader header = algorithms::file_header<T, n, m>(0, m_alignment);
+        char padding[MEMORY_ALIGNMENT] = {};
+        std::fwrite(&header, sizeof(header), 1, m_file);
+        for (std::uint64_t i = sizeof(header); i < header.offset; i += MEMORY_ALIGNMENT) {
+            std::fwrite(padding, 1, header.offset - i < MEMORY_ALIGNMENT ? header.offset - i : MEMORY_ALIGNMENT, m_file);
+        }
+    }
+
+    MatrixFileWriter (const MatrixFileWriter&) = delete;
+
+    MatrixFileWriter& operator = (const MatrixFileWriter&) = delete;
+
+    ~MatrixFileWriter (void) {
+#if USE_STD_EXCEPTIONS
+        try {
+            close();
+        } catch (...) {
+        }
+#else
+        close();
+#endif
+    }
+
+/*!
+  признак открытого файла
+*/
+    bool good (void) const {
+        return m_file != nullptr;
+    }
+
+/*!
+  количество записанных матриц
+*/
+    std::uint64_t size (void) const {
+        return m_count;
+    }
+
+/*!
+  запись матрицы
+  \param M - матрица \a n x \a m
+  \return ссылка на себя
+*/
+    template<typename S>
+    MatrixFileWriter& write (const GenericMatrix<T, n, m, S>& M) {
+        return write(M.array(), 1);
+    }
+
+/*!
+  запись нескольких матриц, расположенных в памяти подряд
+  \param array - массив \a count * \a n * \a m элементов
+  \param count - количество матриц
+  \return ссылка на себя
+*/
+    MatrixFileWriter& write (const T* array, std::uint64_t count) {
+        if (m_file && count) {
+            std::uint64_t written = std::fwrite(array, sizeof(T) * n * m, count, m_file);
+            m_count += written;
+            if (written != count) {
+                algorithms::file_error("can't write matrix file");
+            }
+        }
+        return *this;
+    }
+
+/*!
+  запись количества матриц в заголовок и закрытие файла
+  \return \a true при успешной записи
+*/
+    bool close (void) {
+        if (!m_file) {
+            return false;
+        }
+        MatrixFileHeader header = algorithms::file_header<T, n, m>(m_count, m_alignment);
+        bool ok = !std::fseek(m_file, 0, SEEK_SET) && std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+        ok = !std::fclose(m_file) && ok;
+        m_file = nullptr;
+        return ok || algorithms::file_error("can't write matrix file");
+    }
+};
+
+/*! \class MappedMatrixFile
+  \brief Шаблон MappedMatrixFile - файл матриц, отображенный в память, без разбора и копирования записей
+  \tparam T - тип элементов матриц
+  \tparam n - количество строк матриц
+  \tparam m - количество столбцов матриц
+
+  Записи доступны как константные ссылки на матрицы со встроенным хранением, указывающие прямо в
+  отображение файла; они действительны, пока существует объект. Несоответствие заголовка типу
+  и размеру матриц вызывает исключение std::runtime_error (при USE_STD_EXCEPTIONS), иначе файл
+  считается пустым.
+*/
+template<typename T, int n, int m>
+class MappedMatrixFile {
+public:
+/*! \typedef MatrixType
+  тип записи файла
+*/
+    typedef GenericMatrix<T, n, m, storage::Inline> MatrixType;
+private:
+    static_assert(sizeof(MatrixType) == sizeof(T) * n * m, "matrix record must be a plain array of elements");
+
+    char* m_data;
+    std::uint64_t m_size;
+    const MatrixType* m_records;
+    std::uint64_t m_count;
+
+    void open (const char* path) {
+#if USE_MMAP
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            algorithms::file_error("can't open matrix file");
+            return;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) || st.st_size == 0) {
+            ::close(fd);
+            algorithms::file_error("can't open matrix file");
+            return;
+        }
+        void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            algorithms::file_error("can't map matrix file");
+            return;
+        }
+        m_data = static_cast<char*>(data);
+        m_size = st.st_size;
+#else
+        std::FILE* file = std::fopen(path, "rb");
+        if (!file) {
+            algorithms::file_error("can't open matrix file");
+            return;
+        }
+        std::fseek(file, 0, SEEK_END);
+        long size = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        if (size > 0) {
+            m_data = algorithms::allocate<char>((std::size_t) size);
+            m_size = std::fread(m_data, 1, size, file);
+        }
+        std::fclose(file);
+        if (!m_data) {
+            algorithms::file_error("can't open matrix file");
+            return;
+        }
+#endif
+        MatrixFileHeader header;
+        std::memcpy(&header, m_data, m_size < sizeof(header) ? m_size : sizeof(header));
+        if (!algorithms::check_header<T, n, m>(header, m_size)) {
+            return;
+        }
+        m_records = reinterpret_cast<const MatrixType*>(m_data + header.offset);
+        m_count = header.count;
+    }
+
+    void close (void) {
+        if (m_data) {
+#if USE_MMAP
+            ::munmap(m_data, m_size);
+#else
+            algorithms::deallocate(m_data);
+#endif
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_records = nullptr;
+        m_count = 0;
+    }
+public:
+/*!
+  \param path - путь к файлу
+*/
+    explicit MappedMatrixFile (const char* path) : m_data(nullptr), m_size(0), m_records(nullptr), m_count(0) {
+#if USE_STD_EXCEPTIONS
+        try {
+            open(path);
+        } catch (...) {
+            close();
+            throw;
+        }
+#else
+        open(path);
+#endif
+    }
+
+    MappedMatrixFile (const MappedMatrixFile&) = delete;
+
+    MappedMatrixFile& operator = (const MappedMatrixFile&) = delete;
+
+    MappedMatrixFile (MappedMatrixFile&& other) noexcept : m_data(other.m_data), m_size(other.m_size), m_records(other.m_records), m_count(other.m_count) {
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_records = nullptr;
+        other.m_count = 0;
+    }
+
+    ~MappedMatrixFile (void) {
+        close();
+    }
+
+/*!
+  количество матриц в файле
+*/
+    std::uint64_t size (void) const {
+        return m_count;
+    }
+
+/*!
+  оператор индексации
+  \param index - номер записи
+  \return константная ссылка на матрицу в отображении файла
+*/
+    const MatrixType& operator [] (std::uint64_t index) const {
+        return m_records[index];
+    }
+
+/*!
+  указатель на первую запись
+*/
+    const MatrixType* begin (void) const {
+        return m_records;
+    }
+
+/*!
+  указатель за последней записью
+*/
+    const MatrixType* end (void) const {
+        return m_records + m_count;
+    }
+};
+
+}
+
+#endif
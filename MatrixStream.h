@@ -0,0 +1,256 @@
+#ifndef _MATRIX_MATRIXSTREAM_H
+#define _MATRIX_MATRIXSTREAM_H
+
+#include <iosfwd>
+#include <cstdint>
+#include <cstring>
+#include <GenericMatrix.h>
+#include <MatrixFile.h>
+#include "algorithms.h"
+#include "aligned.h"
+
+/*! \def STREAM_BUFFER_SIZE
+  Размер буфера (в байтах) потоковой записи и чтения матриц
+*/
+
+#ifndef STREAM_BUFFER_SIZE
+#define STREAM_BUFFER_SIZE (1024 * 1024)
+#endif
+
+namespace Matrix {
+
+/*! \class MatrixStreamWriter
+  \brief Шаблон MatrixStreamWriter - буферизованная запись последовательности матриц в бинарный поток
+  \tparam T - тип элементов матриц
+  \tparam n - количество строк матриц
+  \tparam m - количество столбцов матриц
+  \tparam Stream - тип потока вывода с методом write(const char*, size) (и good() для проверки записи)
+
+  Массивы элементов матриц копируются в буфер целиком и передаются в поток вызовами write размером
+  с буфер. С общим заголовком поток начинается с заголовка формата MatrixFileHeader (количество записей 0 -
+  до конца потока), за которым идут только элементы; без него каждой матрице предшествуют ее размеры
+  (два 32-битных целых).
+*/
+template<typename T, int n, int m, typename Stream = std::ostream>
+class MatrixStreamWriter {
+    Stream& m_stream;
+    char* m_buffer;
+    int m_capacity;
+    int m_used;
+    bool m_header;
+
+    void put (const void* data, std::uint64_t size) {
+        if (m_used + size > (std::uint64_t) m_capacity) {
+            flush();
+            if (size >= (std::uint64_t) m_capacity) {
+                m_stream.write(static_cast<const char*>(data), size);
+                return;
+            }
+        }
+        std::memcpy(m_buffer + m_used, data, size);
+        m_used += size;
+    }
+public:
+/*!
+  \param stream - поток вывода (открытый в двоичном режиме)
+  \param header - запись общего заголовка вместо размеров каждой матрицы
+  \param capacity - размер буфера в байтах
+*/
+    explicit MatrixStreamWriter (Stream& stream, bool header = true, int capacity = STREAM_BUFFER_SIZE) : m_stream(stream), m_buffer(algorithms::allocate<char>(capacity)), m_capacity(capacity), m_used(0), m_header(header) {
+        if (m_header) {
+            MatrixFileHeader H = algorithms::file_header<T, n, m>(0, sizeof(MatrixFileHeader));
+            put(&H, sizeof(H));
+        }
+    }
+
+    MatrixStreamWriter (const MatrixStreamWriter&) = delete;
+
+    MatrixStreamWriter& operator = (const MatrixStreamWriter&) = delete;
+
+    ~MatrixStreamWriter (void) {
+        flush();
+        algorithms::deallocate(m_buffer);
+    }
+
+/*!
+  запись матрицы
+  \param M - матрица \a n x \a m
+  \return ссылка на себя
+*/
+    template<typename S>
+    MatrixStreamWriter& write (const GenericMatrix<T, n, m, S>& M) {
+        return write(M.array(), 1);
+    }
+
+/*!
+  запись нескольких матриц, расположенных в памяти подряд
+  \param array - массив \a count * \a n * \a m элементов
+  \param count - количество матриц
+  \return ссылка на себя
+*/
+    MatrixStreamWriter& write (const T* array, std::uint64_t count) {
+        if (m_header) {
+            put(array, count * n * m * sizeof(T));
+            return *this;
+        }
+        const std::int32_t size[2] = {n, m};
+        for (std::uint64_t i = 0; i < count; ++i) {
+            put(size, sizeof(size));
+            put(array + i * n * m, n * m * sizeof(T));
+        }
+        return *this;
+    }
+
+/*!
+  признак успешной записи
+  \return состояние потока (данные, оставшиеся в буфере, передаются в поток вызовом flush)
+*/
+    bool good (void) const {
+        return m_stream.good();
+    }
+
+/*!
+  передача содержимого буфера в поток
+*/
+    void flush (void) {
+        if (m_used) {
+            m_stream.write(m_buffer, m_used);
+            m_used = 0;
+        }
+    }
+};
+
+/*! \class MatrixStreamReader
+  \brief Шаблон MatrixStreamReader - буферизованное чтение последовательности матриц из бинарного потока
+  \tparam T - тип элементов матриц
+  \tparam n - количество строк матриц
+  \tparam m - количество столбцов матриц
+  \tparam Stream - тип потока ввода с методами read(char*, size) и gcount()
+
+  Читает потоки, записанные MatrixStreamWriter с тем же признаком общего заголовка, и файлы
+  MatrixFileWriter: ненулевое количество записей в заголовке ограничивает чтение. Несоответствие
+  заголовка или размеров матрицы вызывает исключение std::runtime_error (при USE_STD_EXCEPTIONS),
+  иначе чтение прекращается.
+*/
+template<typename T, int n, int m, typename Stream = std::istream>
+class MatrixStreamReader {
+    Stream& m_stream;
+    char* m_buffer;
+    int m_capacity;
+    int m_begin;
+    int m_end;
+    bool m_header;
+    bool m_good;
+    std::uint64_t m_remaining;
+
+    std::uint64_t get (void* data, std::uint64_t size) {
+        char* dst = static_cast<char*>(data);
+        std::uint64_t done = 0;
+        while (done < size) {
+            if (m_begin == m_end) {
+                if (size - done >= (std::uint64_t) m_capacity) {
+                    m_stream.read(dst + done, size - done);
+                    return done + m_stream.gcount();
+                }
+                m_stream.read(m_buffer, m_capacity);
+                m_begin = 0;
+                m_end = m_stream.gcount();
+                if (!m_end) {
+                    break;
+                }
+            }
+            std::uint64_t cnt = m_end - m_begin;
+            if (cnt > size - done) {
+                cnt = size - done;
+            }
+            std::memcpy(dst + done, m_buffer + m_begin, cnt);
+            m_begin += cnt;
+            done += cnt;
+        }
+        return done;
+    }
+public:
+/*!
+  \param stream - поток ввода (открытый в двоичном режиме)
+  \param header - поток начинается с общего заголовка вместо размеров каждой матрицы
+  \param capacity - размер буфера в байтах
+*/
+    explicit MatrixStreamReader (Stream& stream, bool header = true, int capacity = STREAM_BUFFER_SIZE) : m_stream(stream), m_buffer(algorithms::allocate<char>(capacity)), m_capacity(capacity), m_begin(0), m_end(0), m_header(header), m_good(true), m_remaining(UINT64_MAX) {
+        if (m_header) {
+            MatrixFileHeader H;
+            m_good = get(&H, sizeof(H)) == sizeof(H) && algorithms::check_header<T, n, m>(H);
+            if (m_good && H.count) {
+                m_remaining = H.count;
+            }
+            for (std::uint64_t i = sizeof(H); m_good && i < H.offset; ++i) {
+                char skip;
+                m_good = get(&skip, 1) == 1;
+            }
+        }
+    }
+
+    MatrixStreamReader (const MatrixStreamReader&) = delete;
+
+    MatrixStreamReader& operator = (const MatrixStreamReader&) = delete;
+
+    ~MatrixStreamReader (void) {
+        algorithms::deallocate(m_buffer);
+    }
+
+/*!
+  признак возможности дальнейшего чтения
+  \return \a false после конца потока или ошибки
+*/
+    bool good (void) const {
+        return m_good;
+    }
+
+/*!
+  чтение матрицы
+  \param M - матрица \a n x \a m
+  \return \a true, если матрица прочитана целиком
+*/
+    template<typename S>
+    bool read (GenericMatrix<T, n, m, S>& M) {
+        return read(M.array(), 1) == 1;
+    }
+
+/*!
+  чтение нескольких матриц в память подряд
+  \param array - массив \a count * \a n * \a m элементов
+  \param count - наибольшее количество матриц
+  \return количество прочитанных целиком матриц
+*/
+    std::uint64_t read (T* array, std::uint64_t count) {
+        if (!m_good) {
+            return 0;
+        }
+        const std::uint64_t size = n * m * sizeof(T);
+        if (m_header) {
+            std::uint64_t done = get(array, (count < m_remaining ? count : m_remaining) * size) / size;
+            m_remaining -= done;
+            m_good = done == count;
+            return done;
+        }
+        for (std::uint64_t i = 0; i < count; ++i) {
+            std::int32_t dims[2];
+            if (get(dims, sizeof(dims)) != sizeof(dims)) {
+                m_good = false;
+                return i;
+            }
+            if (dims[0] != n || dims[1] != m) {
+                m_good = algorithms::file_error("matrix size corrupted");
+                return i;
+            }
+            if (get(array + i * n * m, size) != size) {
+                m_good = false;
+                return i;
+            }
+        }
+        return count;
+    }
+};
+
+}
+
+#endif
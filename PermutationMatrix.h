@@ -0,0 +1,231 @@
+#ifndef _MATRIX_PERMUTATIONMATRIX_H
+#define _MATRIX_PERMUTATIONMATRIX_H
+
+#include <null_t.h>
+#include <identity_t.h>
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class PermutationMatrix
+  \brief Шаблон PermutationMatrix - матрица перестановки, хранящая только перестановку индексов
+  \tparam n - количество строк и столбцов матрицы
+
+  Строка \a i матрицы перестановки содержит единицу в столбце \a P[i]: умножение слева переставляет строки
+  матрицы (строка \a i произведения - строка \a P[i] множителя), умножение справа - столбцы.
+*/
+template<int n>
+class PermutationMatrix {
+    int m_array[n];
+public:
+/*!
+  количество строк матрицы
+*/
+    static const int rows = n;
+
+/*!
+  количество столбцов матрицы
+*/
+    static const int columns = n;
+
+/*!
+  конструктор по умолчанию (единичная перестановка)
+*/
+    MATRIX_CONSTEXPR PermutationMatrix (void) : m_array() {
+        for (int i = 0; i < n; ++i) {
+            m_array[i] = i;
+        }
+    }
+
+/*!
+  конструктор из литерала единичной матрицы
+*/
+    MATRIX_CONSTEXPR PermutationMatrix (identity_t) : PermutationMatrix() {
+    }
+
+/*!
+  конструктор из списка инициализации
+  \param list - столбцы единиц в строках матрицы
+*/
+    MATRIX_CONSTEXPR PermutationMatrix (const std::initializer_list<int>& list) : m_array() {
+        algorithms::cp(m_array, list, n);
+    }
+
+/*!
+  оператор присваивания матрице значения единичной матрицы
+*/
+    MATRIX_CONSTEXPR PermutationMatrix& operator = (identity_t) {
+        return *this = PermutationMatrix();
+    }
+
+/*!
+  оператор индексации
+  \param row - индекс строки матрицы
+  \return индекс столбца, в котором строка \a row содержит единицу
+*/
+    MATRIX_CONSTEXPR const int& operator [] (int row) const {
+        return m_array[row];
+    }
+
+/*!
+  оператор индексации
+  \param row - индекс строки матрицы
+  \return ссылка на индекс столбца, в котором строка \a row содержит единицу
+*/
+    MATRIX_CONSTEXPR int& operator [] (int row) {
+        return m_array[row];
+    }
+
+/*!
+  перестановка двух строк матрицы (умножение слева на матрицу транспозиции)
+  \param i - индекс первой строки
+  \param j - индекс второй строки
+  \return матрица с переставленными строками
+*/
+    MATRIX_CONSTEXPR PermutationMatrix& swap (int i, int j) {
+        int swap = m_array[i];
+        m_array[i] = m_array[j];
+        m_array[j] = swap;
+        return *this;
+    }
+
+/*!
+  плотная матрица перестановки
+  \return квадратная матрица из нулей и единиц
+*/
+    template<typename T>
+    MATRIX_CONSTEXPR SquareMatrix<T, n> matrix (void) const {
+        SquareMatrix<T, n> M = null;
+        for (int i = 0; i < n; ++i) {
+            M[i][m_array[i]] = 1;
+        }
+        return M;
+    }
+
+/*!
+  массив перестановки
+  \return константный указатель на массив индексов
+*/
+    MATRIX_CONSTEXPR const int* array (void) const {
+        return m_array;
+    }
+
+/*!
+  матрица транспозиции
+  \param i - индекс первой строки и первого столбца матрицы транспозиции
+  \param j - индекс второй строки и второго столбца матрицы транспозиции
+  \return единичная перестановка, в которой переставлены \a i и \a j
+*/
+    static MATRIX_CONSTEXPR PermutationMatrix transposition (int i, int j) {
+        return PermutationMatrix().swap(i, j);
+    }
+};
+
+/*! \relates PermutationMatrix
+  оператор равенства
+*/
+template<int n>
+MATRIX_CONSTEXPR bool operator == (const PermutationMatrix<n>& lhs, const PermutationMatrix<n>& rhs) {
+    return algorithms::cmp(lhs.array(), rhs.array(), n, 1);
+}
+
+/*! \relates PermutationMatrix
+  оператор неравенства
+*/
+template<int n>
+MATRIX_CONSTEXPR bool operator != (const PermutationMatrix<n>& lhs, const PermutationMatrix<n>& rhs) {
+    return !algorithms::cmp(lhs.array(), rhs.array(), n, 1);
+}
+
+/*! \relates PermutationMatrix
+  произведение матриц перестановки (композиция перестановок)
+  \param lhs - первый множитель
+  \param rhs - второй множитель
+  \return матрица перестановки \a lhs * \a rhs
+*/
+template<int n>
+MATRIX_CONSTEXPR PermutationMatrix<n> operator * (const PermutationMatrix<n>& lhs, const PermutationMatrix<n>& rhs) {
+    PermutationMatrix<n> P;
+    for (int i = 0; i < n; ++i) {
+        P[i] = rhs[lhs[i]];
+    }
+    return P;
+}
+
+/*! \relates PermutationMatrix
+  перестановка строк матрицы за O(n * m)
+  \param lhs - матрица перестановки \a n x \a n
+  \param rhs - матрица \a n x \a m
+  \return матрица \a rhs с переставленными строками
+*/
+template<typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const PermutationMatrix<n>& lhs, const GenericMatrix<T, n, m, S>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::permute_rows(R.array(), rhs.array(), lhs.array(), n, m);
+    return R;
+}
+
+/*! \relates PermutationMatrix
+  перестановка столбцов матрицы за O(n * m)
+  \param lhs - матрица \a n x \a m
+  \param rhs - матрица перестановки \a m x \a m
+  \return матрица \a lhs с переставленными столбцами
+*/
+template<typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const GenericMatrix<T, n, m, S>& lhs, const PermutationMatrix<m>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::permute_columns(R.array(), lhs.array(), rhs.array(), n, m);
+    return R;
+}
+
+/*! \relates PermutationMatrix
+  обратная матрица перестановки (равна транспонированной)
+  \param P - матрица перестановки
+  \return обратная перестановка
+*/
+template<int n>
+MATRIX_CONSTEXPR PermutationMatrix<n> inverse (const PermutationMatrix<n>& P) {
+    PermutationMatrix<n> R;
+    for (int i = 0; i < n; ++i) {
+        R[P[i]] = i;
+    }
+    return R;
+}
+
+/*! \relates PermutationMatrix
+  транспонирование матрицы перестановки
+  \param P - матрица перестановки
+  \return обратная перестановка
+*/
+template<int n>
+MATRIX_CONSTEXPR PermutationMatrix<n> transpose (const PermutationMatrix<n>& P) {
+    return inverse(P);
+}
+
+/*! \relates PermutationMatrix
+  определитель матрицы перестановки (четность перестановки, по циклам)
+  \param P - матрица перестановки
+  \return 1 для четной перестановки, -1 для нечетной
+*/
+template<int n>
+MATRIX_CONSTEXPR int det (const PermutationMatrix<n>& P) {
+    bool visited[n] = {};
+    int D = 1;
+    for (int i = 0; i < n; ++i) {
+        if (visited[i]) {
+            continue;
+        }
+        for (int j = P[i]; j != i; j = P[j]) {
+            visited[j] = true;
+            D = -D;
+        }
+        visited[i] = true;
+    }
+    return D;
+}
+
+}
+
+#endif
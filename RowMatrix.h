@@ -13,50 +13,88 @@ namespace Matrix {
 */
 template<typename T, int n>
 class RowMatrix : public GenericMatrix<T, 1, n> {
-protected:
-    using GenericMatrix<T, 1, n>::m_array;
 public:
 /*!
   конструктор по умолчанию
 */
-    RowMatrix (void) : GenericMatrix<T, 1, n>() {
+    MATRIX_CONSTEXPR RowMatrix (void) : GenericMatrix<T, 1, n>() {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    RowMatrix (const RowMatrix<T, n>& other) : GenericMatrix<T, 1, n>(other) {
+    MATRIX_CONSTEXPR RowMatrix (const RowMatrix<T, n>& other) : GenericMatrix<T, 1, n>(other) {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    RowMatrix (const GenericMatrix<T, 1, n>& other) : GenericMatrix<T, 1, n>(other) {
+    MATRIX_CONSTEXPR RowMatrix (const GenericMatrix<T, 1, n>& other) : GenericMatrix<T, 1, n>(other) {
+    }
+
+/*!
+  конструктор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR RowMatrix (RowMatrix<T, n>&& other) noexcept : GenericMatrix<T, 1, n>(std::move(other)) {
+    }
+
+/*!
+  конструктор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR RowMatrix (GenericMatrix<T, 1, n>&& other) noexcept : GenericMatrix<T, 1, n>(std::move(other)) {
+    }
+
+/*!
+  конструктор из отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR RowMatrix (const GenericExpression<E, T, 1, n>& expression) : GenericMatrix<T, 1, n>(expression) {
     }
 
 /*!
   конструктор из литерала нулевой матрицы
 */
-    RowMatrix (null_t literal) : GenericMatrix<T, 1, n>(literal) {
+    MATRIX_CONSTEXPR RowMatrix (null_t literal) : GenericMatrix<T, 1, n>(literal) {
     }
 
 /*!
   конструктор из списка инициализации
   \param list - список инициализации
 */
-    RowMatrix (const std::initializer_list<T>& list) {
+    MATRIX_CONSTEXPR RowMatrix (const std::initializer_list<T>& list) {
         algorithms::cp(this->array(), list, n);
     }
 
+/*!
+  оператор копирования
+  \param other - копируемая матрица
+*/
+    MATRIX_CONSTEXPR RowMatrix& operator = (const RowMatrix<T, n>& other) {
+        GenericMatrix<T, 1, n>::operator = (other);
+        return *this;
+    }
+
+/*!
+  оператор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR RowMatrix& operator = (RowMatrix<T, n>&& other) noexcept {
+        GenericMatrix<T, 1, n>::operator = (std::move(other));
+        return *this;
+    }
+
 /*!
   оператор индексации
   \param column - индекс столбца матрицы
   \return константная ссылка на элемент в массиве элементов матрицы
 */
-    const T& operator[] (int column) const {
-        return m_array[0][column];
+    MATRIX_CONSTEXPR const T& operator[] (int column) const {
+        return this->array()[column];
     }
 
 /*!
@@ -64,8 +102,8 @@ public:
   \param column - индекс столбца матрицы
   \return ссылка на элемент в массиве элементов матрицы
 */
-    T& operator[] (int column) {
-        return m_array[0][column];
+    MATRIX_CONSTEXPR T& operator[] (int column) {
+        return this->array()[column];
     }
 };
 
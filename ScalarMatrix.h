@@ -14,56 +14,62 @@ template<typename T>
 class ScalarMatrix : public GenericMatrix<T, 1, 1> {
 private:
     void operator [] (int); // объявление запрещает использование оператора [] для ScalarMatrix
-protected:
-    using GenericMatrix<T, 1, 1>::m_array;
 public:
 /*!
   конструктор по умолчанию
 */
-    ScalarMatrix (void) : GenericMatrix<T, 1, 1>() {
+    MATRIX_CONSTEXPR ScalarMatrix (void) : GenericMatrix<T, 1, 1>() {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    ScalarMatrix (const ScalarMatrix& other) : GenericMatrix<T, 1, 1>(other) {
+    MATRIX_CONSTEXPR ScalarMatrix (const ScalarMatrix& other) : GenericMatrix<T, 1, 1>(other) {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    ScalarMatrix (const GenericMatrix<T, 1, 1>& other) : GenericMatrix<T, 1, 1>(other) {
+    MATRIX_CONSTEXPR ScalarMatrix (const GenericMatrix<T, 1, 1>& other) : GenericMatrix<T, 1, 1>(other) {
+    }
+
+/*!
+  конструктор из отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR ScalarMatrix (const GenericExpression<E, T, 1, 1>& expression) : GenericMatrix<T, 1, 1>(expression) {
     }
 
 /*!
   конструктор из литерала нулевой матрицы
 */
-    ScalarMatrix (null_t) : GenericMatrix<T, 1, 1>() {
-        m_array[0][0] = 0;
+    MATRIX_CONSTEXPR ScalarMatrix (null_t) : GenericMatrix<T, 1, 1>() {
+        this->array()[0] = 0;
     }
 
 /*!
   конструктор из литерала единичной матрицы
 */
-    ScalarMatrix (identity_t) : GenericMatrix<T, 1, 1>() {
-        m_array[0][0] = 1;
+    MATRIX_CONSTEXPR ScalarMatrix (identity_t) : GenericMatrix<T, 1, 1>() {
+        this->array()[0] = 1;
     }
 
 /*!
   конструктор из скаляра
   \param s - скаляр инициализации
 */
-    ScalarMatrix (const T& s) : GenericMatrix<T, 1, 1>() {
-        m_array[0][0] = s;
+    MATRIX_CONSTEXPR ScalarMatrix (const T& s) : GenericMatrix<T, 1, 1>() {
+        this->array()[0] = s;
     }
 
 /*!
   оператор присваивания скаляру единичного значения
 */
-    ScalarMatrix& operator = (identity_t) {
-        m_array[0][0] = 1;
+    MATRIX_CONSTEXPR ScalarMatrix& operator = (identity_t) {
+        this->array()[0] = 1;
         return *this;
     }
 
@@ -71,8 +77,8 @@ public:
   оператор копирования скаляра
   \param s - копируемый скаляр
 */
-    ScalarMatrix& operator = (const T& s) {
-        m_array[0][0] = s;
+    MATRIX_CONSTEXPR ScalarMatrix& operator = (const T& s) {
+        this->array()[0] = s;
         return *this;
     }
 
@@ -80,8 +86,8 @@ public:
   оператор приведения к скалярному типу
   \return единственный элемент матрицы
 */
-    operator T (void) const {
-        return m_array[0][0];
+    MATRIX_CONSTEXPR operator T (void) const {
+        return this->array()[0];
     }
 };
 
@@ -4,6 +4,7 @@
 #include <GenericMatrix.h>
 #include <identity_t.h>
 #include "algorithms.h"
+#include "fixed.h"
 
 namespace Matrix {
 
@@ -20,33 +21,55 @@ public:
 /*!
   конструктор по умолчанию
 */
-    SquareMatrix (void) : GenericMatrix<T, n, n>() {
+    MATRIX_CONSTEXPR SquareMatrix (void) : GenericMatrix<T, n, n>() {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    SquareMatrix (const SquareMatrix& other) : GenericMatrix<T, n, n>(other) {
+    MATRIX_CONSTEXPR SquareMatrix (const SquareMatrix& other) : GenericMatrix<T, n, n>(other) {
     }
 
 /*!
   конструктор копирования
   \param other - копируемая матрица
 */
-    SquareMatrix (const GenericMatrix<T, n, n>& other) : GenericMatrix<T, n, n>(other) {
+    MATRIX_CONSTEXPR SquareMatrix (const GenericMatrix<T, n, n>& other) : GenericMatrix<T, n, n>(other) {
+    }
+
+/*!
+  конструктор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR SquareMatrix (SquareMatrix&& other) noexcept : GenericMatrix<T, n, n>(std::move(other)) {
+    }
+
+/*!
+  конструктор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR SquareMatrix (GenericMatrix<T, n, n>&& other) noexcept : GenericMatrix<T, n, n>(std::move(other)) {
+    }
+
+/*!
+  конструктор из отложенного выражения
+  \param expression - выражение, вычисляемое за один проход по элементам
+*/
+    template<typename E>
+    MATRIX_CONSTEXPR SquareMatrix (const GenericExpression<E, T, n, n>& expression) : GenericMatrix<T, n, n>(expression) {
     }
 
 /*!
   конструктор из литерала нулевой матрицы
 */
-    SquareMatrix (null_t literal) : GenericMatrix<T, n, n>(literal) {
+    MATRIX_CONSTEXPR SquareMatrix (null_t literal) : GenericMatrix<T, n, n>(literal) {
     }
 
 /*!
   конструктор из литерала единичной матрицы
 */
-    SquareMatrix (identity_t) : GenericMatrix<T, n, n>() {
+    MATRIX_CONSTEXPR SquareMatrix (identity_t) : GenericMatrix<T, n, n>() {
         algorithms::identity(this->array(), n);
     }
 
@@ -54,13 +77,31 @@ public:
   конструктор из списка инициализации
   \param list - список инициализации
 */
-    SquareMatrix (const std::initializer_list<std::initializer_list<T>>& list) : GenericMatrix<T, n, n>(list) {
+    MATRIX_CONSTEXPR SquareMatrix (const std::initializer_list<std::initializer_list<T>>& list) : GenericMatrix<T, n, n>(list) {
+    }
+
+/*!
+  оператор копирования
+  \param other - копируемая матрица
+*/
+    MATRIX_CONSTEXPR SquareMatrix& operator = (const SquareMatrix& other) {
+        GenericMatrix<T, n, n>::operator = (other);
+        return *this;
+    }
+
+/*!
+  оператор перемещения
+  \param other - перемещаемая матрица
+*/
+    MATRIX_CONSTEXPR SquareMatrix& operator = (SquareMatrix&& other) noexcept {
+        GenericMatrix<T, n, n>::operator = (std::move(other));
+        return *this;
     }
 
 /*!
   оператор присваивания матрице значения единичной матрицы
 */
-    SquareMatrix& operator = (identity_t) {
+    MATRIX_CONSTEXPR SquareMatrix& operator = (identity_t) {
         algorithms::identity(this->array(), n);
         return *this;
     }
@@ -70,23 +111,23 @@ public:
   \param other - другая матрица
   \return матрица, умноженная справа на \a other
 */
-    SquareMatrix& operator *= (const SquareMatrix& other) {
+    MATRIX_CONSTEXPR SquareMatrix& operator *= (const SquareMatrix& other) {
         return *this = *this * other;
     }
 
 /*!
   одновременное вычисление определителя и обратной матрицы (в случае ненулевого определителя)
-  \param inverse - ссылка на матрицу, которая будет приравнена к обратной (не поменяется в случае нулевого определителя)
+  \param inverse - ссылка на матрицу, которая будет приравнена к обратной (не поменяется в случае вырожденности матрицы)
   \return определитель матрицы
 */
-    T det (SquareMatrix<T, n>&) const;
+    MATRIX_CONSTEXPR T det (SquareMatrix<T, n>&) const;
 
 /*!
   диагональная матрица
   \param array - массив диагональных элементов
   \return диагональная матрица с заданными элементами
 */
-    static const SquareMatrix diag (const T array[]);
+    static MATRIX_CONSTEXPR SquareMatrix diag (const T array[]);
 
 /*!
   матрица транспозиции
@@ -94,27 +135,34 @@ public:
   \param j - индекс второй строки и второго столбца матрицы транспозиции
   \return единичная матрица, в которой единицы на позициях (\a i, \a i) и (\a j, \a j) заменены на единицы в позициях (\a i, \a j) и (\a j, \a i)
 */
-    static const SquareMatrix transposition (int i, int j);
+    static MATRIX_CONSTEXPR SquareMatrix transposition (int i, int j);
 };
 
 template<typename T, int n>
-T SquareMatrix<T, n>::det (SquareMatrix<T, n>& inverse) const {
-    SquareMatrix<T, n> E = identity;
-    GenericMatrix<T, n, 2 * n> C = cat(E, *this);
-    T D = algorithms::gauss(C.array(), n);
-    inverse = minor<T, n, 2 * n, n, n>(C);
+MATRIX_CONSTEXPR T SquareMatrix<T, n>::det (SquareMatrix<T, n>& inverse) const {
+    if (n <= algorithms::fixed::size) {
+        return algorithms::fixed::inverse(inverse.array(), this->array(), n);
+    }
+    algorithms::Scratch<T> A(n * n);
+    algorithms::Scratch<int> pivot(n);
+    algorithms::cp(A.data(), this->array(), n * n);
+    bool singular;
+    T D = algorithms::gauss_jordan(A.data(), pivot.data(), n, &singular);
+    if (!singular) {
+        algorithms::cp(inverse.array(), A.data(), n * n);
+    }
     return D;
 }
 
 template<typename T, int n>
-const SquareMatrix<T, n> SquareMatrix<T, n>::diag (const T array[]) {
+MATRIX_CONSTEXPR SquareMatrix<T, n> SquareMatrix<T, n>::diag (const T array[]) {
     SquareMatrix E;
     algorithms::diag(E.array(), array, n);
     return E;
 }
 
 template<typename T, int n>
-const SquareMatrix<T, n> SquareMatrix<T, n>::transposition (int i, int j) {
+MATRIX_CONSTEXPR SquareMatrix<T, n> SquareMatrix<T, n>::transposition (int i, int j) {
     SquareMatrix<T, n> P = identity;
     P[i][i] = 0;
     P[j][j] = 0;
@@ -129,23 +177,27 @@ const SquareMatrix<T, n> SquareMatrix<T, n>::transposition (int i, int j) {
   \return матрица, обратная к \a M (нулевая матрица в случае вырожденности \a M)
 */
 template<typename T, int n>
-const SquareMatrix<T, n> inverse (const SquareMatrix<T, n>& M) {
-    SquareMatrix<T, n> inverse;
-    if (M.det(inverse) == 0) {
-        inverse = SquareMatrix<T, n>::null();
-    }
+MATRIX_CONSTEXPR SquareMatrix<T, n> inverse (const SquareMatrix<T, n>& M) {
+    SquareMatrix<T, n> inverse = null;
+    M.det(inverse);
     return inverse;
 }
 
 /*! \relates SquareMatrix
-  вычисление определителя матрицы
+  вычисление определителя матрицы (по явной формуле для матриц до 4 x 4, иначе LU-разложением, без вычисления обратной матрицы)
   \param M - матрица
-  \return определитель \a M
+  \return определитель \a M (0 для вырожденной матрицы, как в M.det(inverse))
 */
 template<typename T, int n>
-T det (const SquareMatrix<T, n>& M) {
-    SquareMatrix<T, n> inverse;
-    return M.det(inverse);
+MATRIX_CONSTEXPR T det (const SquareMatrix<T, n>& M) {
+    if (n <= algorithms::fixed::size) {
+        T D = algorithms::fixed::det(M.array(), n);
+        return algorithms::fixed::singular(M.array(), D, n) ? 0 : D;
+    }
+    algorithms::Scratch<T> LU(n * n);
+    algorithms::cp(LU.data(), M.array(), n * n);
+    algorithms::Scratch<int> pivot(n);
+    return algorithms::lu(LU.data(), pivot.data(), n);
 }
 
 /*! \relates SquareMatrix
@@ -154,7 +206,7 @@ T det (const SquareMatrix<T, n>& M) {
   \return след \a M
 */
 template<typename T, int n>
-T tr (const SquareMatrix<T, n>& M) {
+MATRIX_CONSTEXPR T tr (const SquareMatrix<T, n>& M) {
     return algorithms::tr(M.array(), n);
 }
 
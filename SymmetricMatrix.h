@@ -0,0 +1,378 @@
+#ifndef _MATRIX_SYMMETRICMATRIX_H
+#define _MATRIX_SYMMETRICMATRIX_H
+
+#include <null_t.h>
+#include <identity_t.h>
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include <LU.h>
+#include <Cholesky.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class SymmetricMatrix
+  \brief Шаблон SymmetricMatrix - класс реализации математических операций с симметричными матрицами
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк и столбцов матрицы
+
+  Хранится только верхний треугольник матрицы, построчно (n * (n + 1) / 2 элементов).
+*/
+template<typename T, int n>
+class SymmetricMatrix {
+public:
+/*! \typedef ElementType
+  тип элементов матрицы
+*/
+    typedef T ElementType;
+
+/*!
+  количество строк матрицы
+*/
+    static const int rows = n;
+
+/*!
+  количество столбцов матрицы
+*/
+    static const int columns = n;
+
+/*!
+  количество хранимых элементов матрицы
+*/
+    static const int size = n * (n + 1) / 2;
+private:
+/*! \class RowConst
+  \brief Класс RowConst - константный указатель на строку матрицы
+*/
+    class RowConst {
+        const T* m_array;
+        int m_row;
+        RowConst (const T* array, int row) : m_array(array), m_row(row) {
+        }
+        RowConst (const RowConst& other);
+        RowConst& operator = (const RowConst& other);
+    public:
+        const T& operator [] (int column) const {
+            return m_array[SymmetricMatrix::index(m_row, column)];
+        }
+    friend const RowConst SymmetricMatrix::operator [] (int) const;
+    };
+
+/*! \class Row
+  \brief Класс Row - указатель на строку матрицы (элементы (i, j) и (j, i) совпадают)
+*/
+    class Row {
+        T* m_array;
+        int m_row;
+        Row (T* array, int row) : m_array(array), m_row(row) {
+        }
+        Row (const Row& other);
+        Row& operator = (const Row& other);
+    public:
+        T& operator [] (int column) const {
+            return m_array[SymmetricMatrix::index(m_row, column)];
+        }
+    friend const Row SymmetricMatrix::operator [] (int);
+    };
+protected:
+/*!
+  массив элементов верхнего треугольника матрицы
+*/
+    T m_array[size];
+public:
+/*!
+  конструктор по умолчанию
+*/
+    SymmetricMatrix (void) {
+    }
+
+/*!
+  конструктор из литерала нулевой матрицы
+*/
+    SymmetricMatrix (null_t) {
+        algorithms::null(array(), size, 1);
+    }
+
+/*!
+  конструктор из литерала единичной матрицы
+*/
+    SymmetricMatrix (identity_t) {
+        algorithms::sym_identity(array(), n);
+    }
+
+/*!
+  конструктор из квадратной матрицы
+  \param M - квадратная матрица, из которой берется верхний треугольник
+*/
+    explicit SymmetricMatrix (const SquareMatrix<T, n>& M) {
+        algorithms::sym_pack(array(), M.array(), n);
+    }
+
+/*!
+  оператор обнуления матрицы
+*/
+    SymmetricMatrix& operator = (null_t) {
+        algorithms::null(array(), size, 1);
+        return *this;
+    }
+
+/*!
+  оператор присваивания матрице значения единичной матрицы
+*/
+    SymmetricMatrix& operator = (identity_t) {
+        algorithms::sym_identity(array(), n);
+        return *this;
+    }
+
+/*!
+  оператор умножения на скаляр
+  \param scalar - скалярный множитель
+  \return матрица, умноженная на \a scalar
+*/
+    SymmetricMatrix& operator *= (const T& scalar) {
+        algorithms::mul(array(), scalar, size, 1);
+        return *this;
+    }
+
+/*!
+  оператор прибавления другой матрицы
+  \param other - другая матрица
+  \return матрица, увеличенная на \a other
+*/
+    SymmetricMatrix& operator += (const SymmetricMatrix& other) {
+        algorithms::add(array(), other.array(), size, 1);
+        return *this;
+    }
+
+/*!
+  оператор вычитания другой матрицы
+  \param other - другая матрица
+  \return матрица, уменьшенная на \a other
+*/
+    SymmetricMatrix& operator -= (const SymmetricMatrix& other) {
+        algorithms::sub(array(), other.array(), size, 1);
+        return *this;
+    }
+
+/*!
+  оператор приведения к квадратной матрице
+  \return квадратная матрица с заполненными обоими треугольниками
+*/
+    operator const SquareMatrix<T, n> (void) const {
+        SquareMatrix<T, n> M;
+        algorithms::sym_unpack(M.array(), array(), n);
+        return M;
+    }
+
+/*!
+  оператор индексации
+  \param row - индекс строки матрицы
+  \return объект \a RowConst - константный указатель на строку матрицы
+*/
+    const RowConst operator [] (int row) const {
+        return RowConst(array(), row);
+    }
+
+/*!
+  оператор индексации
+  \param row - индекс строки матрицы
+  \return объект \a Row - указатель на строку матрицы
+*/
+    const Row operator [] (int row) {
+        return Row(array(), row);
+    }
+
+/*!
+  индекс элемента в массиве элементов верхнего треугольника
+  \param row - индекс строки матрицы
+  \param column - индекс столбца матрицы
+  \return индекс элемента (\a row, \a column) или симметричного ему
+*/
+    static int index (int row, int column) {
+        return algorithms::sym_index(row, column, n);
+    }
+
+/*!
+  массив элементов матрицы
+  \return константный указатель на начало массива элементов верхнего треугольника
+*/
+    const T* array (void) const {
+        return m_array;
+    }
+
+/*!
+  массив элементов матрицы
+  \return указатель на начало массива элементов верхнего треугольника
+*/
+    T* array (void) {
+        return m_array;
+    }
+};
+
+/*! \relates SymmetricMatrix
+  оператор равенства
+  \param lhs - левая сторона равенства
+  \param rhs - правая сторона равенства
+  \return \a true, если матрицы \a lhs и \a rhs совпадают поэлементно
+*/
+template<typename T, int n>
+bool operator == (const SymmetricMatrix<T, n>& lhs, const SymmetricMatrix<T, n>& rhs) {
+    return algorithms::cmp(lhs.array(), rhs.array(), SymmetricMatrix<T, n>::size, 1);
+}
+
+/*! \relates SymmetricMatrix
+  оператор неравенства
+  \param lhs - левая сторона неравенства
+  \param rhs - правая сторона неравенства
+  \return \a true, если матрицы \a lhs и \a rhs отличаются хотя бы в одном элементе
+*/
+template<typename T, int n>
+bool operator != (const SymmetricMatrix<T, n>& lhs, const SymmetricMatrix<T, n>& rhs) {
+    return !algorithms::cmp(lhs.array(), rhs.array(), SymmetricMatrix<T, n>::size, 1);
+}
+
+/*! \relates SymmetricMatrix
+  оператор сложения
+  \param lhs - первое слагаемое
+  \param rhs - второе слагаемое
+  \return сумма матриц \a lhs и \a rhs
+*/
+template<typename T, int n>
+SymmetricMatrix<T, n> operator + (const SymmetricMatrix<T, n>& lhs, const SymmetricMatrix<T, n>& rhs) {
+    SymmetricMatrix<T, n> M = lhs;
+    M += rhs;
+    return M;
+}
+
+/*! \relates SymmetricMatrix
+  оператор унарного минуса
+  \param rhs - матрица
+  \return матрица, противоположная к \a rhs
+*/
+template<typename T, int n>
+SymmetricMatrix<T, n> operator - (const SymmetricMatrix<T, n>& rhs) {
+    SymmetricMatrix<T, n> M = null;
+    M -= rhs;
+    return M;
+}
+
+/*! \relates SymmetricMatrix
+  оператор вычитания
+  \param lhs - уменьшаемая матрица
+  \param rhs - вычитаемая матрица
+  \return разность матриц \a lhs и \a rhs
+*/
+template<typename T, int n>
+SymmetricMatrix<T, n> operator - (const SymmetricMatrix<T, n>& lhs, const SymmetricMatrix<T, n>& rhs) {
+    SymmetricMatrix<T, n> M = lhs;
+    M -= rhs;
+    return M;
+}
+
+/*! \relates SymmetricMatrix
+  оператор умножения матрицы и скаляра
+  \param lhs - матричный множитель
+  \param rhs - скалярный множитель
+  \return произведение матрицы \a lhs и скаляра \a rhs
+*/
+template<typename T, int n>
+SymmetricMatrix<T, n> operator * (const SymmetricMatrix<T, n>& lhs, const T& rhs) {
+    SymmetricMatrix<T, n> M = lhs;
+    M *= rhs;
+    return M;
+}
+
+/*! \relates SymmetricMatrix
+  оператор умножения скаляра и матрицы
+  \param lhs - скалярный множитель
+  \param rhs - матричный множитель
+  \return произведение скаляра \a lhs и матрицы \a rhs
+*/
+template<typename T, int n>
+SymmetricMatrix<T, n> operator * (const T& lhs, const SymmetricMatrix<T, n>& rhs) {
+    SymmetricMatrix<T, n> M = rhs;
+    M *= lhs;
+    return M;
+}
+
+/*! \relates SymmetricMatrix
+  сопряжение симметричной матрицы другой матрицей (первое произведение вычисляется по упакованной
+  матрице, второе - только для верхнего треугольника результата)
+  \tparam n - количество строк и столбцов в результирующей матрице
+  \tparam m - количество строк и столбцов в исходной матрице
+  \param M - сопрягаемая симметричная матрица \a m x \a m
+  \param C - сопрягающая матрица \a n x \a m
+  \return \a M, умноженная слева на \a C и справа на транспонированную \a C
+*/
+template<typename T, int n, int m>
+SymmetricMatrix<T, n> conjugate (const SymmetricMatrix<T, m>& M, const GenericMatrix<T, n, m>& C) {
+    GenericMatrix<T, n, m> CM;
+    algorithms::mul_sym(CM.array(), C.array(), M.array(), n, m);
+    SymmetricMatrix<T, n> R;
+    algorithms::sym_mul_transposed(R.array(), CM.array(), C.array(), n, m);
+    return R;
+}
+
+/*! \relates SymmetricMatrix
+  транспонированное сопряжение симметричной матрицы другой матрицей (первое произведение вычисляется
+  по упакованной матрице, второе - только для верхнего треугольника результата)
+  \tparam n - количество строк и столбцов в результирующей матрице
+  \tparam m - количество строк и столбцов в исходной матрице
+  \param M - сопрягаемая симметричная матрица \a m x \a m
+  \param C - сопрягающая матрица \a m x \a n
+  \return \a M, умноженная слева на транспонированную \a C и справа на \a C
+*/
+template<typename T, int n, int m>
+SymmetricMatrix<T, n> conjugate_transposed (const SymmetricMatrix<T, m>& M, const GenericMatrix<T, m, n>& C) {
+    GenericMatrix<T, m, n> MC;
+    algorithms::sym_mul(MC.array(), M.array(), C.array(), m, n);
+    SymmetricMatrix<T, n> R;
+    algorithms::sym_transposed_mul(R.array(), C.array(), MC.array(), n, m);
+    return R;
+}
+
+/*! \relates SymmetricMatrix
+  вычисление обратной матрицы (разложением Холецкого для положительно определенной \a M, иначе LU-разложением)
+  \param M - симметричная матрица
+  \return симметричная матрица, обратная к \a M (нулевая матрица в случае вырожденности \a M)
+*/
+template<typename T, int n>
+SymmetricMatrix<T, n> inverse (const SymmetricMatrix<T, n>& M) {
+    const SquareMatrix<T, n> F = M;
+    Cholesky<T, n> C(F);
+    if (C.positive()) {
+        return SymmetricMatrix<T, n>(C.inverse());
+    }
+    return SymmetricMatrix<T, n>(LU<T, n>(F).inverse());
+}
+
+/*! \relates SymmetricMatrix
+  вычисление определителя матрицы (разложением Холецкого для положительно определенной \a M, иначе LU-разложением)
+  \param M - симметричная матрица
+  \return определитель \a M
+*/
+template<typename T, int n>
+T det (const SymmetricMatrix<T, n>& M) {
+    const SquareMatrix<T, n> F = M;
+    Cholesky<T, n> C(F);
+    if (C.positive()) {
+        return C.det();
+    }
+    return LU<T, n>(F).det();
+}
+
+/*! \relates SymmetricMatrix
+  запись матрицы в поток вывода (в виде полной квадратной матрицы)
+  \tparam Stream - тип потока вывода
+  \param stream - поток вывода
+  \param M - матрица
+  \return поток вывода
+*/
+template<typename T, int n, typename Stream>
+Stream& operator << (Stream& stream, const SymmetricMatrix<T, n>& M) {
+    return stream << (const SquareMatrix<T, n>) M;
+}
+
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef _MATRIX_TRANSPOSEDVIEW_H
+#define _MATRIX_TRANSPOSEDVIEW_H
+
+#include <GenericExpression.h>
+#include <GenericMatrix.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class TransposedView
+  \brief Шаблон TransposedView - транспонированная матрица без копирования элементов
+  \tparam T - тип элементов матрицы
+  \tparam n - количество строк исходной матрицы
+  \tparam m - количество столбцов исходной матрицы
+  \tparam S - способ хранения исходной матрицы
+
+  Представление хранит ссылку на исходную матрицу и является выражением \a m x \a n.
+  Произведения с представлением вычисляются ядрами умножения на транспонированную матрицу, которые читают
+  исходные матрицы построчно.
+*/
+template<typename T, int n, int m, typename S>
+class TransposedView : public GenericExpression<TransposedView<T, n, m, S>, T, m, n> {
+    const GenericMatrix<T, n, m, S>& m_matrix;
+public:
+/*!
+  \param M - транспонируемая матрица (должна существовать, пока используется представление)
+*/
+    explicit MATRIX_CONSTEXPR TransposedView (const GenericMatrix<T, n, m, S>& M) : m_matrix(M) {
+    }
+
+/*!
+  исходная матрица
+*/
+    MATRIX_CONSTEXPR const GenericMatrix<T, n, m, S>& matrix (void) const {
+        return m_matrix;
+    }
+
+    MATRIX_CONSTEXPR T item (int index) const {
+        return m_matrix.array()[index % n * m + index / n];
+    }
+};
+
+/*! \relates TransposedView
+  транспонирование матрицы без копирования элементов
+  \tparam n - количество строк исходной матрицы
+  \tparam m - количество столбцов исходной матрицы
+  \param M - матрица \a n x \a m
+  \return представление \a M как транспонированной матрицы \a m x \a n
+*/
+template<typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR TransposedView<T, n, m, S> transposed (const GenericMatrix<T, n, m, S>& M) {
+    return TransposedView<T, n, m, S>(M);
+}
+
+/*! \relates TransposedView
+  произведение транспонированной матрицы на матрицу (для \a lhs, представляющего \a rhs, вычисляется
+  только верхний треугольник симметричного результата)
+  \tparam n - количество строк результата
+  \tparam k - количество строк исходных матриц
+  \tparam m - количество столбцов результата
+  \param lhs - транспонированная матрица \a k x \a n
+  \param rhs - матрица \a k x \a m
+  \return произведение \a lhs и \a rhs, матрица \a n x \a m
+*/
+template<typename T, int n, int k, int m, typename S1, typename S2>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const TransposedView<T, k, n, S1>& lhs, const GenericMatrix<T, k, m, S2>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::transposed_mul(R.array(), lhs.matrix().array(), rhs.array(), n, k, m, lhs.matrix().array() == rhs.array());
+    return R;
+}
+
+/*! \relates TransposedView
+  произведение матрицы на транспонированную матрицу (для \a rhs, представляющего \a lhs, вычисляется
+  только верхний треугольник симметричного результата)
+  \tparam n - количество строк результата
+  \tparam k - количество столбцов исходных матриц
+  \tparam m - количество столбцов результата
+  \param lhs - матрица \a n x \a k
+  \param rhs - транспонированная матрица \a m x \a k
+  \return произведение \a lhs и \a rhs, матрица \a n x \a m
+*/
+template<typename T, int n, int k, int m, typename S1, typename S2>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const GenericMatrix<T, n, k, S1>& lhs, const TransposedView<T, m, k, S2>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::mul_transposed(R.array(), lhs.array(), rhs.matrix().array(), n, k, m, lhs.array() == rhs.matrix().array());
+    return R;
+}
+
+/*! \relates TransposedView
+  произведение транспонированных матриц без транспонирования и промежуточных матриц
+  \tparam n - количество строк результата
+  \tparam k - количество строк исходной матрицы \a lhs
+  \tparam m - количество столбцов результата
+  \param lhs - транспонированная матрица \a k x \a n
+  \param rhs - транспонированная матрица \a m x \a k
+  \return произведение \a lhs и \a rhs, матрица \a n x \a m
+*/
+template<typename T, int n, int k, int m, typename S1, typename S2>
+MATRIX_CONSTEXPR GenericMatrix<T, n, m> operator * (const TransposedView<T, k, n, S1>& lhs, const TransposedView<T, m, k, S2>& rhs) {
+    GenericMatrix<T, n, m> R;
+    algorithms::transposed_mul_transposed(R.array(), lhs.matrix().array(), rhs.matrix().array(), n, k, m);
+    return R;
+}
+
+}
+
+#endif
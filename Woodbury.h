@@ -0,0 +1,291 @@
+#ifndef _MATRIX_WOODBURY_H
+#define _MATRIX_WOODBURY_H
+
+#include <algorithm>
+#include <cmath>
+#include <null_t.h>
+#include <identity_t.h>
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include <ColumnMatrix.h>
+#include <RowMatrix.h>
+#include <precision.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \class Woodbury
+  \brief Шаблон Woodbury - обратная матрица и определитель, обновляемые при изменениях малого ранга
+  \tparam T - тип элементов матрицы (с плавающей точкой)
+  \tparam n - количество строк и столбцов матрицы
+
+  Обратная матрица и определитель вычисляются один раз в конструкторе LU-разложением. Изменение
+  M += U V^T ранга k учитывается за O(n^2 k) по формуле Шермана-Моррисона-Вудбери и лемме об
+  определителе матрицы вместо повторного обращения за O(n^3). Определитель хранится как мантисса
+  и двоичный порядок, поэтому последовательные обновления не приводят к переполнению или исчезновению
+  порядка; вырожденность определяется по ведущим элементам разложения, а не по определителю.
+  После каждого обновления за O(n^2) проверяется относительная невязка
+  |M x - p| / (|M| |x| + |p|), x = M^-1 p, для двух пробных векторов p; если она превышает допуск
+  или обновление вырождено, обратная матрица и определитель вычисляются заново.
+*/
+template<typename T, int n>
+class Woodbury {
+    SquareMatrix<T, n> m_M;
+    SquareMatrix<T, n> m_inverse;
+    T m_det;
+    int m_exponent;
+    bool m_singular;
+    T m_tolerance;
+
+    void scale (const T& factor) {
+        int exponent;
+        int shift;
+        T mantissa = std::frexp(factor, &exponent);
+        m_det = std::frexp(m_det * mantissa, &shift);
+        m_exponent += exponent + shift;
+    }
+
+    void recompute (void) {
+        algorithms::Scratch<T> LU(n * n);
+        algorithms::Scratch<int> pivot(n);
+        algorithms::cp(LU.data(), m_M.array(), n * n);
+        algorithms::lu(LU.data(), pivot.data(), n, &m_singular);
+        m_det = 0;
+        m_exponent = 0;
+        m_inverse = null;
+        if (m_singular) {
+            return;
+        }
+        m_det = 1;
+        for (int j = 0; j < n; ++j) {
+            scale(pivot[j] != j ? -LU[j * n + j] : LU[j * n + j]);
+        }
+        m_inverse = identity;
+        algorithms::lu_solve(LU.data(), pivot.data(), m_inverse.array(), n, n);
+    }
+
+    bool check (void) {
+        if (drift() > m_tolerance) {
+            recompute();
+            return false;
+        }
+        return true;
+    }
+
+    bool sherman_morrison (const T* u, const T* v) {
+        algorithms::Scratch<T> x(n);
+        algorithms::Scratch<T> y(n);
+        if (singular()) {
+            recompute();
+            return false;
+        }
+        algorithms::mul(x.data(), m_inverse.array(), u, n, n, 1);
+        algorithms::mul(y.data(), v, m_inverse.array(), 1, n, n);
+        T vx = algorithms::dot(v, x.data(), n);
+        T s = 1 + vx;
+        if (algorithms::abs(s) <= precision<T>() * (1 + algorithms::abs(vx))) {
+            recompute();
+            return false;
+        }
+        scale(s);
+        for (int i = 0; i < n; ++i) {
+            T xi = x[i] / s;
+            T* row = m_inverse.array() + i * n;
+            for (int j = 0; j < n; ++j) {
+                row[j] -= xi * y[j];
+            }
+        }
+        return check();
+    }
+
+    T residual (const T* p) const {
+        algorithms::Scratch<T> x(n);
+        algorithms::Scratch<T> r(n);
+        algorithms::mul(x.data(), m_inverse.array(), p, n, n, 1);
+        algorithms::mul(r.data(), m_M.array(), x.data(), n, n, 1);
+        T R = 0;
+        T M = 0;
+        T X = 0;
+        T P = 0;
+        for (int i = 0; i < n; ++i) {
+            const T* row = m_M.array() + i * n;
+            T S = 0;
+            for (int j = 0; j < n; ++j) {
+                S += algorithms::abs(row[j]);
+            }
+            M = std::max(M, S);
+            R = std::max(R, algorithms::abs(r[i] - p[i]));
+            X = std::max(X, algorithms::abs(x[i]));
+            P = std::max(P, algorithms::abs(p[i]));
+        }
+        return R / (M * X + P);
+    }
+public:
+/*!
+  конструктор, вычисляющий обратную матрицу и определитель
+  \param M - исходная матрица
+  \param tolerance - допустимая относительная невязка обратной матрицы, при превышении которой она вычисляется заново
+*/
+    explicit Woodbury (const SquareMatrix<T, n>& M, T tolerance = std::sqrt(precision<T>())) : m_M(M), m_det(0), m_exponent(0), m_singular(true), m_tolerance(tolerance) {
+        recompute();
+    }
+
+/*!
+  признак вырожденности матрицы
+  \return \a true, если один из ведущих элементов LU-разложения не превышает precision
+*/
+    bool singular (void) const {
+        return m_singular;
+    }
+
+/*!
+  определитель текущей матрицы
+  \return определитель (0 для вырожденной матрицы; может обратиться в 0 или бесконечность
+  и для невырожденной матрицы, если не представим типом \a T)
+*/
+    T det (void) const {
+        return std::ldexp(m_det, m_exponent);
+    }
+
+/*!
+  определитель текущей матрицы в виде мантиссы и двоичного порядка
+  \param exponent - ссылка на двоичный порядок определителя
+  \return мантисса определителя (по модулю не меньше 1/2 и меньше 1, 0 для вырожденной матрицы)
+*/
+    T det (int& exponent) const {
+        exponent = m_exponent;
+        return m_det;
+    }
+
+/*!
+  обратная матрица
+  \return матрица, обратная к текущей (нулевая матрица в случае вырожденности)
+*/
+    const SquareMatrix<T, n>& inverse (void) const {
+        return m_inverse;
+    }
+
+/*!
+  текущая матрица
+  \return матрица M с учетом всех обновлений
+*/
+    const SquareMatrix<T, n>& matrix (void) const {
+        return m_M;
+    }
+
+/*!
+  относительная невязка обратной матрицы для пробных векторов, O(n^2)
+  \return наибольшее по пробным векторам p значение |M x - p| / (|M| |x| + |p|), x = M^-1 p,
+  в норме максимума модуля (0 для вырожденной матрицы)
+*/
+    T drift (void) const {
+        if (singular()) {
+            return 0;
+        }
+        algorithms::Scratch<T> p(n);
+        for (int i = 0; i < n; ++i) {
+            p[i] = (i % 2 ? -1 : 1) * (1 + T(i) / n);
+        }
+        T R = residual(p.data());
+        for (int i = 0; i < n; ++i) {
+            p[i] = 1 + T(i % 3) / 3;
+        }
+        return std::max(R, residual(p.data()));
+    }
+
+/*!
+  обновление ранга 1: M += u v^T (формула Шермана-Моррисона)
+  \param u - матрица-столбец
+  \param v - матрица-столбец
+  \return \a true, если обновление выполнено за O(n^2), \a false, если обратная матрица вычислена заново
+*/
+    bool update (const ColumnMatrix<T, n>& u, const ColumnMatrix<T, n>& v) {
+        for (int i = 0; i < n; ++i) {
+            T* row = m_M.array() + i * n;
+            for (int j = 0; j < n; ++j) {
+                row[j] += u[i] * v[j];
+            }
+        }
+        return sherman_morrison(u.array(), v.array());
+    }
+
+/*!
+  обновление ранга k: M += U V^T (формула Шермана-Моррисона-Вудбери)
+  \tparam k - ранг обновления
+  \param U - матрица \a n x \a k
+  \param V - матрица \a n x \a k
+  \return \a true, если обновление выполнено за O(n^2 k), \a false, если обратная матрица вычислена заново
+*/
+    template<int k, typename S1, typename S2>
+    bool update (const GenericMatrix<T, n, k, S1>& U, const GenericMatrix<T, n, k, S2>& V) {
+        algorithms::Scratch<T> W(n * n);
+        algorithms::mul_transposed(W.data(), U.array(), V.array(), n, k, n);
+        algorithms::add(m_M.array(), W.data(), n, n);
+        if (singular()) {
+            recompute();
+            return false;
+        }
+        algorithms::Scratch<T> X(n * k);
+        algorithms::Scratch<T> Y(k * n);
+        algorithms::Scratch<T> C(k * k);
+        algorithms::Scratch<T> Z(k * n);
+        algorithms::Scratch<int> pivot(k);
+        algorithms::mul(X.data(), m_inverse.array(), U.array(), n, n, k);
+        algorithms::transposed_mul(Y.data(), V.array(), m_inverse.array(), k, n, n);
+        algorithms::transposed_mul(C.data(), V.array(), X.data(), k, n, k);
+        for (int i = 0; i < k; ++i) {
+            C[i * k + i] += 1;
+        }
+        bool failed;
+        T D = algorithms::gauss_jordan(C.data(), pivot.data(), k, &failed);
+        if (failed) {
+            recompute();
+            return false;
+        }
+        scale(D);
+        algorithms::mul(Z.data(), C.data(), Y.data(), k, k, n);
+        algorithms::mul(W.data(), X.data(), Z.data(), n, k, n);
+        algorithms::sub(m_inverse.array(), W.data(), n, n);
+        return check();
+    }
+
+/*!
+  замена строки матрицы (обновление ранга 1)
+  \param i - индекс строки
+  \param row - новая строка
+  \return \a true, если обновление выполнено за O(n^2), \a false, если обратная матрица вычислена заново
+*/
+    bool replace_row (int i, const RowMatrix<T, n>& row) {
+        algorithms::Scratch<T> u(n);
+        algorithms::Scratch<T> v(n);
+        algorithms::null(u.data(), n, 1);
+        u[i] = 1;
+        for (int j = 0; j < n; ++j) {
+            v[j] = row.array()[j] - m_M[i][j];
+            m_M[i][j] = row.array()[j];
+        }
+        return sherman_morrison(u.data(), v.data());
+    }
+
+/*!
+  замена столбца матрицы (обновление ранга 1)
+  \param j - индекс столбца
+  \param column - новый столбец
+  \return \a true, если обновление выполнено за O(n^2), \a false, если обратная матрица вычислена заново
+*/
+    bool replace_column (int j, const ColumnMatrix<T, n>& column) {
+        algorithms::Scratch<T> u(n);
+        algorithms::Scratch<T> v(n);
+        for (int i = 0; i < n; ++i) {
+            u[i] = column.array()[i] - m_M[i][j];
+            m_M[i][j] = column.array()[i];
+        }
+        algorithms::null(v.data(), n, 1);
+        v[j] = 1;
+        return sherman_morrison(u.data(), v.data());
+    }
+};
+
+}
+
+#endif
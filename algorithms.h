@@ -18,14 +18,43 @@
 #undef minor
 #endif
 
+#include "constexpr.h"
 #include "precision.h"
+#include "simd.h"
+#include "arena.h"
+#include "parallel.h"
+
+/*! \def GEMM_THRESHOLD
+  Минимальное значение n * k * m, начиная с которого умножение матриц выполняется блочным алгоритмом
+*/
+
+#ifndef GEMM_THRESHOLD
+#define GEMM_THRESHOLD (32 * 32 * 32)
+#endif
 
 namespace Matrix {
 
 namespace algorithms {
 
 template<typename T>
-void add (T* lhs, const T* rhs, int n, int m) {
+MATRIX_CONSTEXPR T dot (const T* lhs, const T* rhs, int n);
+
+template<typename T>
+MATRIX_CONSTEXPR void null (T* dst, int n, int m);
+
+/*!
+  модуль числа (в отличие от std::fabs, доступен во время компиляции)
+*/
+template<typename T>
+MATRIX_CONSTEXPR T abs (const T& x) {
+    return x < 0 ? -x : x;
+}
+
+template<typename T>
+MATRIX_CONSTEXPR void add (T* lhs, const T* rhs, int n, int m) {
+    if (!MATRIX_CONSTANT_EVALUATED() && simd::add(lhs, rhs, n * m)) {
+        return;
+    }
     T* _lhs = lhs;
     const T* _rhs = rhs;
     int cnt = n * m;
@@ -35,7 +64,7 @@ void add (T* lhs, const T* rhs, int n, int m) {
 }
 
 template<typename T>
-void cat (T* dst, const T* lhs, const T* rhs, int n, int m1, int m2) {
+MATRIX_CONSTEXPR void cat (T* dst, const T* lhs, const T* rhs, int n, int m1, int m2) {
     T* _dst = dst;
     const T* _lhs = lhs;
     const T* _rhs = rhs;
@@ -52,8 +81,81 @@ void cat (T* dst, const T* lhs, const T* rhs, int n, int m1, int m2) {
     }
 }
 
+/*!
+  разложение Холецкого M = L L^T (на месте)
+  \param array - симметричная матрица \a n x \a n (используется нижний треугольник), заменяемая на L
+  \return \a false, если матрица не является положительно определенной
+*/
+template<typename T>
+bool cholesky (T* array, int n) {
+    for (int j = 0; j < n; ++j) {
+        T* row_j = array + j * n;
+        T d = row_j[j] - dot(row_j, row_j, j);
+        if (d <= precision<T>()) {
+            return false;
+        }
+        d = std::sqrt(d);
+        row_j[j] = d;
+        for (int i = j + 1; i < n; ++i) {
+            T* row_i = array + i * n;
+            row_i[j] = (row_i[j] - dot(row_i, row_j, j)) / d;
+        }
+        null(row_j + j + 1, n - j - 1, 1);
+    }
+    return true;
+}
+
+/*!
+  решение системы по разложению Холецкого (на месте)
+  \param L - нижнетреугольный множитель, полученный функцией cholesky
+  \param array - правые части, матрица \a n x \a m, заменяемая на решение
+*/
+template<typename T>
+void cholesky_solve (const T* L, T* array, int n, int m) {
+    for (int i = 0; i < n; ++i) {
+        T* row_i = array + i * m;
+        for (int j = 0; j < i; ++j) {
+            T mul = L[i * n + j];
+            T* cell_i = row_i;
+            const T* cell_j = array + j * m;
+            int k = m;
+            while (k--) {
+                *cell_i++ -= mul * *cell_j++;
+            }
+        }
+        T diag = L[i * n + i];
+        T* cell_i = row_i;
+        int k = m;
+        while (k--) {
+            *cell_i++ /= diag;
+        }
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        T* row_i = array + i * m;
+        for (int j = i + 1; j < n; ++j) {
+            T mul = L[j * n + i];
+            T* cell_i = row_i;
+            const T* cell_j = array + j * m;
+            int k = m;
+            while (k--) {
+                *cell_i++ -= mul * *cell_j++;
+            }
+        }
+        T diag = L[i * n + i];
+        T* cell_i = row_i;
+        int k = m;
+        while (k--) {
+            *cell_i++ /= diag;
+        }
+    }
+}
+
 template<typename T>
-bool cmp (const T* lhs, const T* rhs, int n, int m) {
+MATRIX_CONSTEXPR bool cmp (const T* lhs, const T* rhs, int n, int m) {
+    bool equal = true;
+    if (!MATRIX_CONSTANT_EVALUATED() && simd::cmp(equal, lhs, rhs, n * m)) {
+        return equal;
+    }
     const T* _lhs = lhs;
     const T* _rhs = rhs;
     int cnt = n * m;
@@ -66,7 +168,7 @@ bool cmp (const T* lhs, const T* rhs, int n, int m) {
 }
 
 template<typename T>
-void cp (T* dst, const T* src, int n, int m) {
+MATRIX_CONSTEXPR void cp (T* dst, const T* src, int n, int m) {
     T* _dst = dst;
     const T* _src = src;
     int cnt = n * m;
@@ -76,7 +178,7 @@ void cp (T* dst, const T* src, int n, int m) {
 }
 
 template<typename T>
-void cp (T* dst, const std::initializer_list<std::initializer_list<T>>& list, int n, int m) {
+MATRIX_CONSTEXPR void cp (T* dst, const std::initializer_list<std::initializer_list<T>>& list, int n, int m) {
 #if USE_STD_EXCEPTIONS
     if ((int) list.size() != n) {
         throw std::runtime_error("wrong matrix initializer size");
@@ -96,7 +198,7 @@ void cp (T* dst, const std::initializer_list<std::initializer_list<T>>& list, in
 }
 
 template<typename T>
-void cp (T* dst, const T* src, int n) {
+MATRIX_CONSTEXPR void cp (T* dst, const T* src, int n) {
     T* _dst = dst;
     const T* _src = src;
     int i = n;
@@ -106,7 +208,7 @@ void cp (T* dst, const T* src, int n) {
 }
 
 template<typename T>
-void cp (T* dst, const std::initializer_list<T>& list, int n) {
+MATRIX_CONSTEXPR void cp (T* dst, const std::initializer_list<T>& list, int n) {
 #if USE_STD_EXCEPTIONS
     if ((int) list.size() != n) {
         throw std::runtime_error("wrong matrix initializer size");
@@ -119,10 +221,13 @@ void cp (T* dst, const std::initializer_list<T>& list, int n) {
 }
 
 template<typename T>
-T dot (const T* lhs, const T* rhs, int n) {
+MATRIX_CONSTEXPR T dot (const T* lhs, const T* rhs, int n) {
+    T S = 0;
+    if (!MATRIX_CONSTANT_EVALUATED() && simd::dot(S, lhs, rhs, n)) {
+        return S;
+    }
     const T* _lhs = lhs;
     const T* _rhs = rhs;
-    T S = 0;
     int i = n;
     while (i--) {
         S += *_lhs++ * *_rhs++;
@@ -130,14 +235,110 @@ T dot (const T* lhs, const T* rhs, int n) {
     return S;
 }
 
+template<typename T, typename E>
+MATRIX_CONSTEXPR void eval (T* dst, const E& expression, int n, int m) {
+    T* _dst = dst;
+    int cnt = n * m;
+    for (int index = 0; index < cnt; ++index) {
+        *_dst++ = expression.item(index);
+    }
+}
+
+/*!
+  вычисление выражения в блок матрицы с шагом строк \a ldd
+*/
+template<typename T, typename E>
+MATRIX_CONSTEXPR void eval (T* dst, int ldd, const E& expression, int n, int m) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            dst[i * ldd + j] = expression.item(i * m + j);
+        }
+    }
+}
+
+template<typename T, typename E>
+MATRIX_CONSTEXPR void eval_add (T* dst, int ldd, const E& expression, int n, int m) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            dst[i * ldd + j] += expression.item(i * m + j);
+        }
+    }
+}
+
+template<typename T, typename E>
+MATRIX_CONSTEXPR void eval_sub (T* dst, int ldd, const E& expression, int n, int m) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            dst[i * ldd + j] -= expression.item(i * m + j);
+        }
+    }
+}
+
+template<typename T, typename E>
+MATRIX_CONSTEXPR void eval_add (T* dst, const E& expression, int n, int m) {
+    T* _dst = dst;
+    int cnt = n * m;
+    for (int index = 0; index < cnt; ++index) {
+        *_dst++ += expression.item(index);
+    }
+}
+
+template<typename L, typename R>
+MATRIX_CONSTEXPR bool eval_cmp (const L& lhs, const R& rhs, int n, int m) {
+    int cnt = n * m;
+    for (int index = 0; index < cnt; ++index) {
+        if (lhs.item(index) != rhs.item(index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename E>
+MATRIX_CONSTEXPR auto eval_norm (const E& expression, int n, int m) -> decltype(expression.item(0)) {
+    decltype(expression.item(0)) S = 0;
+    int cnt = n * m;
+    for (int index = 0; index < cnt; ++index) {
+        auto item = expression.item(index);
+        S += item * item;
+    }
+    return S;
+}
+
+template<typename T, typename E>
+MATRIX_CONSTEXPR void eval_sub (T* dst, const E& expression, int n, int m) {
+    T* _dst = dst;
+    int cnt = n * m;
+    for (int index = 0; index < cnt; ++index) {
+        *_dst++ -= expression.item(index);
+    }
+}
+
+/*
+  вычитание из строки \a i присоединенной матрицы \a n x 2n строки \a j с коэффициентом,
+  обнуляющим элемент (\a i, \a j) правой половины
+*/
+template<typename T>
+MATRIX_CONSTEXPR void eliminate (T* array, int i, int j, int n) {
+    T* cell_i = array + (2 * i + 1) * n + j;
+    T* cell_j = array + (2 * j + 1) * n + j;
+    T mul = *cell_i / *cell_j;
+    cell_i = array + 2 * i * n;
+    cell_j = array + 2 * j * n;
+    int k = 2 * n;
+    while (k--) {
+        *cell_i++ -= mul * *cell_j++;
+    }
+}
+
 template<typename T>
-T gauss (T* array, int n) {
+MATRIX_CONSTEXPR T gauss (T* array, int n) {
     int i, j;
     T D = 1;
     for (j = 0; j < n; ++j) {
         for (i = j; i < n; ++i) {
             const T* cell = array + (2 * i + 1) * n + j;
-            if (fabs(*cell) > precision<T>()) {
+            if (abs(*cell) > precision<T>()) {
                 if (i != j) {
                     T* cell_i = array + 2 * i * n;
                     T* cell_j = array + 2 * j * n;
@@ -155,30 +356,18 @@ T gauss (T* array, int n) {
         if (i == n) {
             return 0;
         }
-        for (i = j + 1; i < n; ++i) {
-            T* cell_i = array + (2 * i + 1) * n + j;
-            T* cell_j = array + (2 * j + 1) * n + j;
-            T mul = *cell_i / *cell_j;
-            cell_i = array + 2 * i * n;
-            cell_j = array + 2 * j * n;
-            int k = 2 * n;
-            while (k--) {
-                *cell_i++ -= mul * *cell_j++;
+        parallel::run(j + 1, n, 2 * n, [=] (int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                eliminate(array, i, j, n);
             }
-        }
+        });
     }
     for (j = 1; j < n; ++j) {
-        for (i = j - 1; i >= 0; --i) {
-            T* cell_i = array + (2 * i + 1) * n + j;
-            T* cell_j = array + (2 * j + 1) * n + j;
-            T mul = *cell_i / *cell_j;
-            cell_i = array + 2 * i * n;
-            cell_j = array + 2 * j * n;
-            int k = 2 * n;
-            while (k--) {
-                *cell_i++ -= mul * *cell_j++;
+        parallel::run(0, j, 2 * n, [=] (int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                eliminate(array, i, j, n);
             }
-        }
+        });
     }
     for (i = 0; i < n; ++i) {
         T* cell = array + (2 * i + 1) * n + i;
@@ -193,8 +382,259 @@ T gauss (T* array, int n) {
     return D;
 }
 
+/*!
+  обращение матрицы методом Гаусса-Жордана на месте, с частичным выбором ведущего элемента
+  \param array - матрица \a n x \a n, заменяемая на обратную (при нулевом определителе содержимое не определено)
+  \param pivot - массив \a n индексов строк, переставленных со строкой j на шаге j
+  \param singular - признак вырожденности: ведущий элемент не превышает precision (может быть 0)
+  \return определитель матрицы (0, если ведущий элемент не превышает precision; произведение
+  ведущих элементов невырожденной матрицы может обратиться в 0 и без этого)
+
+  Вместо присоединенной единичной матрицы обратная накапливается в освобождающихся столбцах,
+  перестановки строк в конце компенсируются перестановками столбцов.
+*/
+template<typename T>
+MATRIX_CONSTEXPR T gauss_jordan (T* array, int* pivot, int n, bool* singular = 0) {
+    T D = 1;
+    if (singular) {
+        *singular = false;
+    }
+    for (int j = 0; j < n; ++j) {
+        int p = j;
+        T max = abs(array[j * n + j]);
+        for (int i = j + 1; i < n; ++i) {
+            T cell = abs(array[i * n + j]);
+            if (cell > max) {
+                max = cell;
+                p = i;
+            }
+        }
+        pivot[j] = p;
+        if (max <= precision<T>()) {
+            if (singular) {
+                *singular = true;
+            }
+            return 0;
+        }
+        T* row_j = array + j * n;
+        if (p != j) {
+            T* cell_p = array + p * n;
+            T* cell_j = row_j;
+            int k = n;
+            while (k--) {
+                T swap = *cell_p;
+                *cell_p++ = *cell_j;
+                *cell_j++ = swap;
+            }
+            D = -D;
+        }
+        T diag = row_j[j];
+        D *= diag;
+        row_j[j] = 1;
+        T* cell_j = row_j;
+        int k = n;
+        while (k--) {
+            *cell_j++ /= diag;
+        }
+        parallel::run(0, n, n, [=] (int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                if (i == j) {
+                    continue;
+                }
+                T* row_i = array + i * n;
+                T mul = row_i[j];
+                row_i[j] = 0;
+                T* cell_i = row_i;
+                const T* _cell_j = row_j;
+                int k = n;
+                while (k--) {
+                    *cell_i++ -= mul * *_cell_j++;
+                }
+            }
+        });
+    }
+    for (int j = n - 1; j >= 0; --j) {
+        int p = pivot[j];
+        if (p != j) {
+            T* row = array;
+            int i = n;
+            while (i--) {
+                T swap = row[p];
+                row[p] = row[j];
+                row[j] = swap;
+                row += n;
+            }
+        }
+    }
+    return D;
+}
+
+namespace blocked {
+
+/*!
+  размеры блоков блочного умножения матриц:
+  MR x NR - блок результата, накапливаемый в регистрах микроядром,
+  MC x KC - упакованная панель левого множителя (кэш L2),
+  KC x NC - упакованная панель правого множителя (кэш L3)
+*/
+enum {MR = 4, NR = 8, MC = 128, KC = 256, NC = 2048};
+
+/*
+  упаковка панелей: элемент (i, p) левого множителя - lhs[i * rs + p * cs], элемент (p, j) правого - rhs[p * rs + j * cs];
+  транспонированный множитель упаковывается перестановкой шагов без отдельного копирования
+*/
+template<typename T>
+void pack_lhs (T* dst, const T* lhs, int rs, int cs, int mc, int kc) {
+    T* _dst = dst;
+    for (int i = 0; i < mc; i += MR) {
+        int mr = mc - i < MR ? mc - i : MR;
+        const T* column = lhs + i * rs;
+        int p = kc;
+        while (p--) {
+            const T* cell = column;
+            int r = 0;
+            for (; r < mr; ++r) {
+                *_dst++ = *cell;
+                cell += rs;
+            }
+            for (; r < MR; ++r) {
+                *_dst++ = 0;
+            }
+            column += cs;
+        }
+    }
+}
+
 template<typename T>
-void diag (T* dst, const T* src, int n) {
+void pack_rhs (T* dst, const T* rhs, int rs, int cs, int kc, int nc) {
+    T* _dst = dst;
+    for (int j = 0; j < nc; j += NR) {
+        int nr = nc - j < NR ? nc - j : NR;
+        const T* row = rhs + j * cs;
+        int p = kc;
+        while (p--) {
+            const T* cell = row;
+            int c = 0;
+            for (; c < nr; ++c) {
+                *_dst++ = *cell;
+                cell += cs;
+            }
+            for (; c < NR; ++c) {
+                *_dst++ = 0;
+            }
+            row += rs;
+        }
+    }
+}
+
+template<typename T>
+void kernel (T* dst, int ldd, const T* lhs, const T* rhs, int kc, int mr, int nr, bool overwrite) {
+    T S[MR][NR] = {};
+    const T* _lhs = lhs;
+    const T* _rhs = rhs;
+    int p = kc;
+    while (p--) {
+        for (int i = 0; i < MR; ++i) {
+            T a = _lhs[i];
+            for (int j = 0; j < NR; ++j) {
+                S[i][j] += a * _rhs[j];
+            }
+        }
+        _lhs += MR;
+        _rhs += NR;
+    }
+    for (int i = 0; i < mr; ++i) {
+        T* cell = dst + i * ldd;
+        if (overwrite) {
+            for (int j = 0; j < nr; ++j) {
+                cell[j] = S[i][j];
+            }
+        } else {
+            for (int j = 0; j < nr; ++j) {
+                cell[j] += S[i][j];
+            }
+        }
+    }
+}
+
+}
+
+/*!
+  блочное умножение матриц с упаковкой панелей множителей
+  (полосы строк результата распределяются по потокам parallel::run)
+  \param dst - результат, матрица \a n x \a m с шагом строк \a ldd
+  \param lhs - первый множитель, матрица \a n x \a k (\a k x \a n, если \a lt) с шагом строк \a ldl
+  \param rhs - второй множитель, матрица \a k x \a m (\a m x \a k, если \a rt) с шагом строк \a ldr
+  \param lt - умножение на транспонированный \a lhs
+  \param rt - умножение на транспонированный \a rhs
+*/
+template<typename T>
+void gemm (T* dst, int ldd, const T* lhs, int ldl, const T* rhs, int ldr, int n, int k, int m, bool lt = false, bool rt = false) {
+    using namespace blocked;
+    int lrs = lt ? 1 : ldl;
+    int lcs = lt ? ldl : 1;
+    int rrs = rt ? 1 : ldr;
+    int rcs = rt ? ldr : 1;
+    if (k == 0) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < m; ++j) {
+                dst[i * ldd + j] = 0;
+            }
+        }
+        return;
+    }
+    int kb = k < KC ? k : KC;
+    int nb = m < NC ? m : NC;
+    int mb = n < MC ? n : MC;
+    Scratch<T> rpanel(kb * ((nb + NR - 1) / NR * NR));
+    for (int jc = 0; jc < m; jc += NC) {
+        int nc = m - jc < NC ? m - jc : NC;
+        for (int pc = 0; pc < k; pc += KC) {
+            int kc = k - pc < KC ? k - pc : KC;
+            pack_rhs(rpanel.data(), rhs + pc * rrs + jc * rcs, rrs, rcs, kc, nc);
+            const T* _rpanel = rpanel.data();
+            parallel::run(0, (n + MR - 1) / MR, (long long) MR * kc * nc, [=] (int begin, int end) {
+                Scratch<T> lpanel(kc * ((mb + MR - 1) / MR * MR));
+                int last = end * MR < n ? end * MR : n;
+                for (int ic = begin * MR; ic < last; ic += MC) {
+                    int mc = last - ic < MC ? last - ic : MC;
+                    pack_lhs(lpanel.data(), lhs + ic * lrs + pc * lcs, lrs, lcs, mc, kc);
+                    for (int jr = 0; jr < nc; jr += NR) {
+                        int nr = nc - jr < NR ? nc - jr : NR;
+                        for (int ir = 0; ir < mc; ir += MR) {
+                            int mr = mc - ir < MR ? mc - ir : MR;
+                            kernel(dst + (ic + ir) * ldd + jc + jr, ldd, lpanel.data() + ir * kc, _rpanel + jr * kc, kc, mr, nr, pc == 0);
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+/*!
+  блочное умножение с заведомо симметричным результатом: для каждой полосы строк вычисляются
+  только блоки от диагонали вправо, нижний треугольник затем отражается
+  \param dst - результат, матрица \a n x \a n
+  \param lhs - первый множитель, матрица \a n x \a k (\a k x \a n, если \a lt) с шагом строк \a ldl
+  \param rhs - второй множитель, матрица \a k x \a n (\a n x \a k, если \a rt) с шагом строк \a ldr
+*/
+template<typename T>
+void gemm_symmetric (T* dst, const T* lhs, int ldl, const T* rhs, int ldr, int n, int k, bool lt, bool rt) {
+    using namespace blocked;
+    for (int i = 0; i < n; i += MC) {
+        int mc = n - i < MC ? n - i : MC;
+        gemm(dst + i * n + i, n, lhs + i * (lt ? 1 : ldl), ldl, rhs + i * (rt ? ldr : 1), ldr, mc, k, n - i, lt, rt);
+    }
+    for (int i = 1; i < n; ++i) {
+        for (int j = 0; j < i; ++j) {
+            dst[i * n + j] = dst[j * n + i];
+        }
+    }
+}
+
+template<typename T>
+MATRIX_CONSTEXPR void diag (T* dst, const T* src, int n) {
     T* _dst = dst;
     const T* _src = src;
     *_dst++ = *_src++;
@@ -208,8 +648,65 @@ void diag (T* dst, const T* src, int n) {
     }
 }
 
+/*!
+  перестановка строк: строка \a i результата - строка \a perm[i] матрицы \a src
+  \param dst - результат, матрица \a n x \a m (не совпадает с \a src)
+  \param src - матрица \a n x \a m
+*/
+template<typename T>
+MATRIX_CONSTEXPR void permute_rows (T* dst, const T* src, const int* perm, int n, int m) {
+    for (int i = 0; i < n; ++i) {
+        cp(dst + i * m, src + perm[i] * m, m);
+    }
+}
+
+/*!
+  перестановка столбцов: столбец \a perm[j] результата - столбец \a j матрицы \a src
+  \param dst - результат, матрица \a n x \a m (не совпадает с \a src)
+  \param src - матрица \a n x \a m
+*/
+template<typename T>
+MATRIX_CONSTEXPR void permute_columns (T* dst, const T* src, const int* perm, int n, int m) {
+    for (int i = 0; i < n; ++i) {
+        T* _dst = dst + i * m;
+        const T* _src = src + i * m;
+        for (int j = 0; j < m; ++j) {
+            _dst[perm[j]] = _src[j];
+        }
+    }
+}
+
+/*!
+  умножение строк матрицы \a n x \a m на элементы диагонали \a diag
+*/
+template<typename T>
+MATRIX_CONSTEXPR void scale_rows (T* dst, const T* src, const T* diag, int n, int m) {
+    for (int i = 0; i < n; ++i) {
+        T* _dst = dst + i * m;
+        const T* _src = src + i * m;
+        T d = diag[i];
+        for (int j = 0; j < m; ++j) {
+            _dst[j] = _src[j] * d;
+        }
+    }
+}
+
+/*!
+  умножение столбцов матрицы \a n x \a m на элементы диагонали \a diag
+*/
+template<typename T>
+MATRIX_CONSTEXPR void scale_columns (T* dst, const T* src, const T* diag, int n, int m) {
+    for (int i = 0; i < n; ++i) {
+        T* _dst = dst + i * m;
+        const T* _src = src + i * m;
+        for (int j = 0; j < m; ++j) {
+            _dst[j] = _src[j] * diag[j];
+        }
+    }
+}
+
 template<typename T>
-void expand (T* dst, const T* src, int i0, int j0, int n, int m, int n1, int m1) {
+MATRIX_CONSTEXPR void expand (T* dst, const T* src, int i0, int j0, int n, int m, int n1, int m1) {
     T* _dst = dst;
     const T* _src = src;
     int i = i0;
@@ -244,7 +741,7 @@ void expand (T* dst, const T* src, int i0, int j0, int n, int m, int n1, int m1)
 }
 
 template<typename T>
-void identity (T* dst, int n) {
+MATRIX_CONSTEXPR void identity (T* dst, int n) {
     T* _dst = dst;
     *_dst++ = 1;
     int i = n - 1;
@@ -257,8 +754,193 @@ void identity (T* dst, int n) {
     }
 }
 
+/*!
+  разложение M = L D L^T (на месте)
+  \param array - симметричная матрица \a n x \a n (используется нижний треугольник), заменяемая на
+  L ниже диагонали (диагональ L единичная) и D на диагонали
+  \return \a false, если один из элементов D не превышает по модулю precision
+*/
+template<typename T>
+bool ldlt (T* array, int n) {
+    for (int j = 0; j < n; ++j) {
+        T* row_j = array + j * n;
+        T d = row_j[j];
+        for (int k = 0; k < j; ++k) {
+            d -= row_j[k] * row_j[k] * array[k * n + k];
+        }
+        if (abs(d) <= precision<T>()) {
+            return false;
+        }
+        row_j[j] = d;
+        for (int i = j + 1; i < n; ++i) {
+            T* row_i = array + i * n;
+            T S = row_i[j];
+            for (int k = 0; k < j; ++k) {
+                S -= row_i[k] * row_j[k] * array[k * n + k];
+            }
+            row_i[j] = S / d;
+        }
+        null(row_j + j + 1, n - j - 1, 1);
+    }
+    return true;
+}
+
+/*!
+  решение системы по разложению L D L^T (на месте)
+  \param LD - множители, полученные функцией ldlt
+  \param array - правые части, матрица \a n x \a m, заменяемая на решение
+*/
+template<typename T>
+void ldlt_solve (const T* LD, T* array, int n, int m) {
+    for (int i = 1; i < n; ++i) {
+        T* row_i = array + i * m;
+        for (int j = 0; j < i; ++j) {
+            T mul = LD[i * n + j];
+            T* cell_i = row_i;
+            const T* cell_j = array + j * m;
+            int k = m;
+            while (k--) {
+                *cell_i++ -= mul * *cell_j++;
+            }
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        T diag = LD[i * n + i];
+        T* cell_i = array + i * m;
+        int k = m;
+        while (k--) {
+            *cell_i++ /= diag;
+        }
+    }
+    for (int i = n - 2; i >= 0; --i) {
+        T* row_i = array + i * m;
+        for (int j = i + 1; j < n; ++j) {
+            T mul = LD[j * n + i];
+            T* cell_i = row_i;
+            const T* cell_j = array + j * m;
+            int k = m;
+            while (k--) {
+                *cell_i++ -= mul * *cell_j++;
+            }
+        }
+    }
+}
+
+/*!
+  LU-разложение с частичным выбором ведущего элемента (на месте)
+  \param array - матрица \a n x \a n, заменяемая на L (ниже диагонали, с единичной диагональю) и U
+  \param pivot - массив \a n индексов строк, переставленных со строкой j на шаге j
+  \param singular - признак вырожденности: ведущий элемент не превышает precision (может быть 0)
+  \return определитель матрицы (0, если ведущий элемент не превышает precision; произведение
+  ведущих элементов невырожденной матрицы может обратиться в 0 и без этого)
+*/
+template<typename T>
+MATRIX_CONSTEXPR T lu (T* array, int* pivot, int n, bool* singular = 0) {
+    T D = 1;
+    if (singular) {
+        *singular = false;
+    }
+    for (int j = 0; j < n; ++j) {
+        int p = j;
+        T max = abs(array[j * n + j]);
+        for (int i = j + 1; i < n; ++i) {
+            T cell = abs(array[i * n + j]);
+            if (cell > max) {
+                max = cell;
+                p = i;
+            }
+        }
+        pivot[j] = p;
+        if (max <= precision<T>()) {
+            if (singular) {
+                *singular = true;
+            }
+            return 0;
+        }
+        if (p != j) {
+            T* cell_p = array + p * n;
+            T* cell_j = array + j * n;
+            int k = n;
+            while (k--) {
+                T swap = *cell_p;
+                *cell_p++ = *cell_j;
+                *cell_j++ = swap;
+            }
+            D = -D;
+        }
+        const T* row_j = array + j * n;
+        T diag = row_j[j];
+        D *= diag;
+        parallel::run(j + 1, n, n - j, [=] (int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                T* row_i = array + i * n;
+                T mul = row_i[j] /= diag;
+                T* cell_i = row_i + j + 1;
+                const T* cell_j = row_j + j + 1;
+                int k = n - j - 1;
+                while (k--) {
+                    *cell_i++ -= mul * *cell_j++;
+                }
+            }
+        });
+    }
+    return D;
+}
+
+/*!
+  решение системы по LU-разложению (на месте)
+  \param lu - LU-разложение матрицы \a n x \a n, полученное функцией lu
+  \param pivot - перестановки строк, полученные функцией lu
+  \param array - правые части, матрица \a n x \a m, заменяемая на решение
+*/
+template<typename T>
+void lu_solve (const T* lu, const int* pivot, T* array, int n, int m) {
+    for (int j = 0; j < n; ++j) {
+        if (pivot[j] != j) {
+            T* cell_p = array + pivot[j] * m;
+            T* cell_j = array + j * m;
+            int k = m;
+            while (k--) {
+                T swap = *cell_p;
+                *cell_p++ = *cell_j;
+                *cell_j++ = swap;
+            }
+        }
+    }
+    for (int i = 1; i < n; ++i) {
+        T* row_i = array + i * m;
+        for (int j = 0; j < i; ++j) {
+            T mul = lu[i * n + j];
+            T* cell_i = row_i;
+            const T* cell_j = array + j * m;
+            int k = m;
+            while (k--) {
+                *cell_i++ -= mul * *cell_j++;
+            }
+        }
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        T* row_i = array + i * m;
+        for (int j = i + 1; j < n; ++j) {
+            T mul = lu[i * n + j];
+            T* cell_i = row_i;
+            const T* cell_j = array + j * m;
+            int k = m;
+            while (k--) {
+                *cell_i++ -= mul * *cell_j++;
+            }
+        }
+        T diag = lu[i * n + i];
+        T* cell_i = row_i;
+        int k = m;
+        while (k--) {
+            *cell_i++ /= diag;
+        }
+    }
+}
+
 template<typename T>
-void minor (T* dst, const T* src, int i0, int j0, int, int m, int n1, int m1) {
+MATRIX_CONSTEXPR void minor (T* dst, const T* src, int i0, int j0, int, int m, int n1, int m1) {
     T* _dst = dst;
     const T* _src = src;
     _src += i0 * m;
@@ -274,7 +956,10 @@ void minor (T* dst, const T* src, int i0, int j0, int, int m, int n1, int m1) {
 }
 
 template<typename T>
-void mul (T* array, T scalar, int n, int m) {
+MATRIX_CONSTEXPR void mul (T* array, T scalar, int n, int m) {
+    if (!MATRIX_CONSTANT_EVALUATED() && simd::mul(array, scalar, n * m)) {
+        return;
+    }
     T* _array = array;
     int cnt = n * m;
     while (cnt--) {
@@ -283,7 +968,11 @@ void mul (T* array, T scalar, int n, int m) {
 }
 
 template<typename T>
-void mul (T* dst, const T* lhs, const T* rhs, int n, int k, int m) {
+MATRIX_CONSTEXPR void mul (T* dst, const T* lhs, const T* rhs, int n, int k, int m) {
+    if (!MATRIX_CONSTANT_EVALUATED() && (long long) n * k * m >= GEMM_THRESHOLD) {
+        gemm(dst, m, lhs, k, rhs, m, n, k, m);
+        return;
+    }
     T* _dst = dst;
     const T* lrow = lhs;
     int i = n;
@@ -291,14 +980,9 @@ void mul (T* dst, const T* lhs, const T* rhs, int n, int k, int m) {
         const T* rcolumn = rhs;
         int j = m;
         while (j--) {
-            const T* lcell = lrow;
-            const T* rcell = rcolumn;
             T S = 0;
-            int l = k;
-            while (l--) {
-                S += *lcell * *rcell;
-                ++lcell;
-                rcell += m;
+            for (int l = 0; l < k; ++l) {
+                S += lrow[l] * rcolumn[l * m];
             }
             *_dst++ = S;
             ++rcolumn;
@@ -307,10 +991,68 @@ void mul (T* dst, const T* lhs, const T* rhs, int n, int k, int m) {
     }
 }
 
+/*!
+  умножение блоков матриц, хранящихся с шагом строк
+  \param dst - результат, блок \a n x \a m с шагом строк \a ldd (не пересекается с множителями)
+  \param lhs - первый множитель, блок \a n x \a k с шагом строк \a ldl
+  \param rhs - второй множитель, блок \a k x \a m с шагом строк \a ldr
+*/
 template<typename T>
-T norm (const T* array, int n, int m) {
-    const T* _array = array;
+MATRIX_CONSTEXPR void mul (T* dst, int ldd, const T* lhs, int ldl, const T* rhs, int ldr, int n, int k, int m) {
+    if (!MATRIX_CONSTANT_EVALUATED() && (long long) n * k * m >= GEMM_THRESHOLD) {
+        gemm(dst, ldd, lhs, ldl, rhs, ldr, n, k, m);
+        return;
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            T S = 0;
+            for (int l = 0; l < k; ++l) {
+                S += lhs[i * ldl + l] * rhs[l * ldr + j];
+            }
+            dst[i * ldd + j] = S;
+        }
+    }
+}
+
+/*!
+  умножение матрицы на транспонированную матрицу без транспонирования
+  \param dst - результат, матрица \a n x \a m
+  \param lhs - первый множитель, матрица \a n x \a k
+  \param rhs - второй множитель, матрица \a m x \a k (используется транспонированной)
+  \param symmetric - результат заведомо симметричен (\a n = \a m): вычисляется верхний треугольник
+  (при блочном умножении - блоки полос строк от диагонали) и отражается
+*/
+template<typename T>
+MATRIX_CONSTEXPR void mul_transposed (T* dst, const T* lhs, const T* rhs, int n, int k, int m, bool symmetric = false) {
+    if (!MATRIX_CONSTANT_EVALUATED() && (long long) n * k * m >= GEMM_THRESHOLD) {
+        if (symmetric) {
+            gemm_symmetric(dst, lhs, k, rhs, k, n, k, false, true);
+        } else {
+            gemm(dst, m, lhs, k, rhs, k, n, k, m, false, true);
+        }
+        return;
+    }
+    const T* lrow = lhs;
+    for (int i = 0; i < n; ++i) {
+        int j = symmetric ? i : 0;
+        for (; j < m; ++j) {
+            T S = dot(lrow, rhs + j * k, k);
+            dst[i * m + j] = S;
+            if (symmetric) {
+                dst[j * m + i] = S;
+            }
+        }
+        lrow += k;
+    }
+}
+
+template<typename T>
+MATRIX_CONSTEXPR T norm (const T* array, int n, int m) {
     T S = 0;
+    if (!MATRIX_CONSTANT_EVALUATED() && simd::norm(S, array, n * m)) {
+        return S;
+    }
+    const T* _array = array;
     int cnt = n * m;
     while (cnt--) {
         T item = *_array++;
@@ -320,7 +1062,10 @@ T norm (const T* array, int n, int m) {
 }
 
 template<typename T>
-void null (T* dst, int n, int m) {
+MATRIX_CONSTEXPR void null (T* dst, int n, int m) {
+    if (!MATRIX_CONSTANT_EVALUATED() && simd::null(dst, n * m)) {
+        return;
+    }
     T* _dst = dst;
     int cnt = n * m;
     while (cnt--) {
@@ -390,7 +1135,10 @@ Stream& print (Stream& stream, const T* array, int n) {
 }
 
 template<typename T>
-void sub (T* lhs, const T* rhs, int n, int m) {
+MATRIX_CONSTEXPR void sub (T* lhs, const T* rhs, int n, int m) {
+    if (!MATRIX_CONSTANT_EVALUATED() && simd::sub(lhs, rhs, n * m)) {
+        return;
+    }
     T* _lhs = lhs;
     const T* _rhs = rhs;
     int cnt = n * m;
@@ -399,8 +1147,165 @@ void sub (T* lhs, const T* rhs, int n, int m) {
     }
 }
 
+inline int sym_index (int i, int j, int n) {
+    if (i > j) {
+        int swap = i;
+        i = j;
+        j = swap;
+    }
+    return i * n - i * (i - 1) / 2 + j - i;
+}
+
+template<typename T>
+void sym_identity (T* dst, int n) {
+    T* _dst = dst;
+    int i = n;
+    while (i--) {
+        *_dst++ = 1;
+        int j = i;
+        while (j--) {
+            *_dst++ = 0;
+        }
+    }
+}
+
+template<typename T>
+void sym_pack (T* dst, const T* src, int n) {
+    T* _dst = dst;
+    const T* row = src;
+    for (int i = 0; i < n; ++i) {
+        const T* _src = row + i;
+        int j = n - i;
+        while (j--) {
+            *_dst++ = *_src++;
+        }
+        row += n;
+    }
+}
+
+template<typename T>
+void sym_unpack (T* dst, const T* src, int n) {
+    const T* _src = src;
+    for (int i = 0; i < n; ++i) {
+        T* _row = dst + i * n + i;
+        T* _column = _row;
+        int j = n - i;
+        while (j--) {
+            *_column = *_src;
+            *_row++ = *_src++;
+            _column += n;
+        }
+    }
+}
+
+template<typename T>
+void sym_mul_transposed (T* dst, const T* lhs, const T* rhs, int n, int m) {
+    T* _dst = dst;
+    for (int i = 0; i < n; ++i) {
+        const T* lrow = lhs + i * m;
+        for (int j = i; j < n; ++j) {
+            *_dst++ = dot(lrow, rhs + j * m, m);
+        }
+    }
+}
+
+template<typename T>
+void sym_transposed_mul (T* dst, const T* lhs, const T* rhs, int n, int m) {
+    null(dst, n * (n + 1) / 2, 1);
+    const T* lrow = lhs;
+    const T* rrow = rhs;
+    int k = m;
+    while (k--) {
+        T* _dst = dst;
+        for (int i = 0; i < n; ++i) {
+            T mul = lrow[i];
+            const T* cell = rrow + i;
+            int j = n - i;
+            while (j--) {
+                *_dst++ += mul * *cell++;
+            }
+        }
+        lrow += n;
+        rrow += n;
+    }
+}
+
+/*!
+  произведение матрицы и симметричной матрицы в упакованном виде (каждый хранимый элемент читается
+  один раз и используется для обеих симметричных позиций)
+  \param dst - произведение, матрица \a n x \a m
+  \param lhs - матрица \a n x \a m
+  \param sym - верхний треугольник симметричной матрицы \a m x \a m, построчно
+*/
 template<typename T>
-T tr (const T* array, int n) {
+void mul_sym (T* dst, const T* lhs, const T* sym, int n, int m) {
+    null(dst, n, m);
+    for (int i = 0; i < n; ++i) {
+        const T* lrow = lhs + i * m;
+        T* drow = dst + i * m;
+        const T* srow = sym;
+        for (int l = 0; l < m; ++l) {
+            T mul = lrow[l];
+            T S = mul * srow[0];
+            for (int p = 1; p < m - l; ++p) {
+                drow[l + p] += mul * srow[p];
+                S += lrow[l + p] * srow[p];
+            }
+            drow[l] += S;
+            srow += m - l;
+        }
+    }
+}
+
+/*!
+  произведение симметричной матрицы в упакованном виде и матрицы (каждый хранимый элемент читается
+  один раз и используется для обеих симметричных позиций)
+  \param dst - произведение, матрица \a n x \a m
+  \param sym - верхний треугольник симметричной матрицы \a n x \a n, построчно
+  \param rhs - матрица \a n x \a m
+*/
+template<typename T>
+void sym_mul (T* dst, const T* sym, const T* rhs, int n, int m) {
+    null(dst, n, m);
+    const T* srow = sym;
+    for (int l = 0; l < n; ++l) {
+        T* drow_l = dst + l * m;
+        const T* rrow_l = rhs + l * m;
+        for (int p = 0; p < n - l; ++p) {
+            T mul = srow[p];
+            T* drow_p = dst + (l + p) * m;
+            const T* rrow_p = rhs + (l + p) * m;
+            for (int j = 0; j < m; ++j) {
+                drow_l[j] += mul * rrow_p[j];
+            }
+            if (p) {
+                for (int j = 0; j < m; ++j) {
+                    drow_p[j] += mul * rrow_l[j];
+                }
+            }
+        }
+        srow += n - l;
+    }
+}
+
+template<typename T>
+bool symmetric (const T* array, int n) {
+    for (int i = 0; i < n; ++i) {
+        const T* _row = array + i * n + i + 1;
+        const T* _column = array + (i + 1) * n + i;
+        int j = n - i - 1;
+        while (j--) {
+            if (*_row++ != *_column) {
+                return false;
+            }
+            _column += n;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+MATRIX_CONSTEXPR T tr (const T* array, int n) {
     const T* _array = array;
     T tr = *_array;
     int i = n - 1;
@@ -411,19 +1316,84 @@ T tr (const T* array, int n) {
     return tr;
 }
 
+/*!
+  умножение транспонированной матрицы на матрицу без транспонирования
+  \param dst - результат, матрица \a n x \a m
+  \param lhs - первый множитель, матрица \a k x \a n (используется транспонированной)
+  \param rhs - второй множитель, матрица \a k x \a m
+  \param symmetric - результат заведомо симметричен (\a n = \a m): вычисляется верхний треугольник
+  (при блочном умножении - блоки полос строк от диагонали) и отражается
+*/
 template<typename T>
-void transpose (T* dst, const T* src, int n, int m) {
+MATRIX_CONSTEXPR void transposed_mul (T* dst, const T* lhs, const T* rhs, int n, int k, int m, bool symmetric = false) {
+    if (!MATRIX_CONSTANT_EVALUATED() && (long long) n * k * m >= GEMM_THRESHOLD) {
+        if (symmetric) {
+            gemm_symmetric(dst, lhs, n, rhs, m, n, k, true, false);
+        } else {
+            gemm(dst, m, lhs, n, rhs, m, n, k, m, true, false);
+        }
+        return;
+    }
+    null(dst, n, m);
+    const T* lrow = lhs;
+    const T* rrow = rhs;
+    int l = k;
+    while (l--) {
+        for (int i = 0; i < n; ++i) {
+            T mul = lrow[i];
+            int j = symmetric ? i : 0;
+            T* cell = dst + i * m + j;
+            const T* rcell = rrow + j;
+            for (; j < m; ++j) {
+                *cell++ += mul * *rcell++;
+            }
+        }
+        lrow += n;
+        rrow += m;
+    }
+    if (symmetric) {
+        for (int i = 1; i < n; ++i) {
+            for (int j = 0; j < i; ++j) {
+                dst[i * m + j] = dst[j * m + i];
+            }
+        }
+    }
+}
+
+/*!
+  умножение транспонированной матрицы на транспонированную матрицу без транспонирования
+  \param dst - результат, матрица \a n x \a m
+  \param lhs - первый множитель, матрица \a k x \a n (используется транспонированной)
+  \param rhs - второй множитель, матрица \a m x \a k (используется транспонированной)
+*/
+template<typename T>
+MATRIX_CONSTEXPR void transposed_mul_transposed (T* dst, const T* lhs, const T* rhs, int n, int k, int m) {
+    if (!MATRIX_CONSTANT_EVALUATED() && (long long) n * k * m >= GEMM_THRESHOLD) {
+        gemm(dst, m, lhs, n, rhs, k, n, k, m, true, true);
+        return;
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            const T* lcell = lhs + i;
+            const T* rcell = rhs + j * k;
+            T S = 0;
+            int l = k;
+            while (l--) {
+                S += *lcell * *rcell++;
+                lcell += n;
+            }
+            dst[i * m + j] = S;
+        }
+    }
+}
+
+template<typename T>
+MATRIX_CONSTEXPR void transpose (T* dst, const T* src, int n, int m) {
     T* _dst = dst;
-    const T* column = src;
-    int j = m;
-    while (j--) {
-        const T* cell = column;
-        int i = n;
-        while (i--) {
-            *_dst++ = *cell;
-            cell += m;
-        }
-        ++column;
+    for (int j = 0; j < m; ++j) {
+        for (int i = 0; i < n; ++i) {
+            *_dst++ = src[i * m + j];
+        }
     }
 }
 
@@ -0,0 +1,60 @@
+#ifndef _MATRIX_ALIGNED_H
+#define _MATRIX_ALIGNED_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+/*! \def MEMORY_ALIGNMENT
+  Выравнивание (в байтах) массивов элементов матриц, размещаемых в куче: не меньше ширины
+  векторного регистра AVX-512 и размера строки кэша
+*/
+
+#ifndef MEMORY_ALIGNMENT
+#define MEMORY_ALIGNMENT 64
+#endif
+
+namespace Matrix {
+
+namespace algorithms {
+
+/*!
+  выделение выровненного массива в куче (для числовых типов, элементы не инициализируются)
+  \param cnt - количество элементов
+  \return указатель на массив, выровненный по MEMORY_ALIGNMENT (нулевой указатель при \a cnt = 0);
+  если массив не выделен, выбрасывается std::bad_alloc
+*/
+template<typename T>
+T* allocate (std::size_t cnt) {
+    if (cnt == 0) {
+        return nullptr;
+    }
+    if (cnt > (SIZE_MAX - MEMORY_ALIGNMENT - sizeof(void*)) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    void* raw = std::malloc(cnt * sizeof(T) + MEMORY_ALIGNMENT + sizeof(void*));
+    if (!raw) {
+        throw std::bad_alloc();
+    }
+    std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + MEMORY_ALIGNMENT - 1) & ~(std::uintptr_t) (MEMORY_ALIGNMENT - 1);
+    reinterpret_cast<void**>(address)[-1] = raw;
+    return reinterpret_cast<T*>(address);
+}
+
+/*!
+  освобождение массива, выделенного функцией allocate
+  \param array - указатель на массив (может быть нулевым)
+*/
+template<typename T>
+void deallocate (T* array) {
+    if (array) {
+        std::free(reinterpret_cast<void**>(array)[-1]);
+    }
+}
+
+}
+
+}
+
+#endif
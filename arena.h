@@ -0,0 +1,170 @@
+#ifndef _MATRIX_ARENA_H
+#define _MATRIX_ARENA_H
+
+#include <cstddef>
+#include <vector>
+#include "constexpr.h"
+#include "aligned.h"
+
+/*! \def ARENA_BLOCK_SIZE
+  Минимальный размер (в байтах) блока памяти, выделяемого потоковой областью временных массивов
+*/
+
+#ifndef ARENA_BLOCK_SIZE
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#endif
+
+namespace Matrix {
+
+namespace algorithms {
+
+/*! \class Arena
+  \brief область временных массивов потока: стековое выделение памяти из блоков, которые не освобождаются до завершения потока
+
+  После первых вычислений область достигает нужного размера, и дальнейшие вычисления не обращаются к куче.
+*/
+class Arena {
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+
+    std::vector<Block> m_blocks;
+    std::size_t m_block;
+    std::size_t m_used;
+
+    Arena (void) : m_block(0), m_used(0) {
+    }
+
+    Arena (const Arena&) = delete;
+    Arena& operator = (const Arena&) = delete;
+
+public:
+/*! \class Mark
+  \brief положение вершины области
+*/
+    struct Mark {
+        std::size_t block;
+        std::size_t used;
+    };
+
+    ~Arena (void) {
+        for (std::size_t i = 0; i < m_blocks.size(); ++i) {
+            deallocate(m_blocks[i].data);
+        }
+    }
+
+/*!
+  область временных массивов текущего потока
+*/
+    static Arena& local (void) {
+        static thread_local Arena arena;
+        return arena;
+    }
+
+/*!
+  текущее положение вершины области
+*/
+    Mark mark (void) const {
+        Mark mark = {m_block, m_used};
+        return mark;
+    }
+
+/*!
+  освобождение всех массивов, выделенных после получения \a mark (блоки памяти сохраняются)
+*/
+    void release (const Mark& mark) {
+        m_block = mark.block;
+        m_used = mark.used;
+    }
+
+/*!
+  выделение массива
+  \param bytes - размер массива в байтах
+  \return указатель на массив, выровненный по MEMORY_ALIGNMENT
+*/
+    void* allocate (std::size_t bytes) {
+        bytes = (bytes + MEMORY_ALIGNMENT - 1) & ~(std::size_t) (MEMORY_ALIGNMENT - 1);
+        for (; m_block < m_blocks.size(); ++m_block, m_used = 0) {
+            if (m_used + bytes <= m_blocks[m_block].size) {
+                void* array = m_blocks[m_block].data + m_used;
+                m_used += bytes;
+                return array;
+            }
+        }
+        std::size_t size = ARENA_BLOCK_SIZE;
+        if (!m_blocks.empty() && size < 2 * m_blocks.back().size) {
+            size = 2 * m_blocks.back().size;
+        }
+        if (size < bytes) {
+            size = bytes;
+        }
+        Block block = {algorithms::allocate<char>(size), size};
+        m_blocks.push_back(block);
+        m_block = m_blocks.size() - 1;
+        m_used = bytes;
+        return block.data;
+    }
+
+/*!
+  предварительное выделение памяти, чтобы первые вычисления не обращались к куче
+  \param bytes - суммарный размер временных массивов в байтах
+*/
+    void reserve (std::size_t bytes) {
+        Mark top = mark();
+        allocate(bytes);
+        release(top);
+    }
+};
+
+/*! \class Scratch
+  \brief временный массив из области текущего потока, освобождаемый при выходе из области видимости
+
+  Временные массивы освобождаются в порядке, обратном выделению, поэтому они создаются только как локальные переменные.
+  При вычислении во время компиляции массив выделяется оператором new.
+*/
+template<typename T>
+class Scratch {
+    T* m_array;
+    Arena* m_arena;
+    Arena::Mark m_mark;
+
+    Scratch (const Scratch&) = delete;
+    Scratch& operator = (const Scratch&) = delete;
+
+public:
+/*!
+  \param cnt - количество элементов (элементы не инициализируются)
+*/
+    MATRIX_CONSTEXPR explicit Scratch (int cnt) : m_array(nullptr), m_arena(nullptr), m_mark() {
+        if (MATRIX_CONSTANT_EVALUATED()) {
+            m_array = new T[cnt];
+        } else {
+            m_arena = &Arena::local();
+            m_mark = m_arena->mark();
+            m_array = static_cast<T*>(m_arena->allocate(cnt * sizeof(T)));
+        }
+    }
+
+    MATRIX_CONSTEXPR ~Scratch (void) {
+        if (m_arena) {
+            m_arena->release(m_mark);
+        } else {
+            delete[] m_array;
+        }
+    }
+
+    MATRIX_CONSTEXPR T* data (void) const {
+        return m_array;
+    }
+
+    MATRIX_CONSTEXPR T& operator [] (int i) const {
+        return m_array[i];
+    }
+};
+
+}
+
+}
+
+#endif
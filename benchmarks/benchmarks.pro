@@ -0,0 +1,8 @@
+TEMPLATE = app
+TARGET = benchmarks
+CONFIG += console c++17 release
+CONFIG -= qt app_bundle
+
+include(../Matrix.pri)
+
+SOURCES += main.cpp
@@ -0,0 +1,291 @@
+/*
+  Микробенчмарки операций с матрицами.
+
+  Для каждой операции, типа элементов и размера матрицы выводится строка CSV:
+  op,type,n,iterations,ns_per_op,gflops,bytes_per_op
+
+  gflops - количество арифметических операций в секунду (0 для операций без арифметики),
+  bytes_per_op - номинальный объем читаемых и записываемых элементов за одну операцию.
+  Количество итераций удваивается, пока время измерения не превысит --min-time секунд.
+
+  Параметры:
+    --filter=<подстрока>  - только операции, имя которых содержит подстроку
+    --type=<тип>          - только один тип элементов (int, float, double, long_double)
+    --max-size=<n>        - только матрицы размера не больше n (по умолчанию 1024)
+    --min-time=<секунды>  - минимальное время измерения (по умолчанию 0.1)
+
+  Определитель и обратная матрица измеряются только для типов с плавающей точкой.
+*/
+
+#include <Matrix.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace Matrix;
+
+namespace {
+
+struct Options {
+    std::string filter;
+    std::string type;
+    int max_size;
+    double min_time;
+};
+
+Options options = {"", "", 1024, 0.1};
+
+/*!
+  барьер оптимизации: результат считается использованным
+*/
+template<typename T>
+inline void keep (const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/*!
+  поток вывода в бинарном виде для pack: элементы копируются в буфер
+*/
+class BinaryBuffer {
+    std::vector<char> m_data;
+public:
+    template<typename T>
+    BinaryBuffer& operator << (const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+        return *this;
+    }
+
+    void clear (void) {
+        m_data.clear();
+    }
+
+    const char* data (void) const {
+        return m_data.data();
+    }
+};
+
+template<typename T>
+const char* type_name (void);
+
+template<>
+const char* type_name<int> (void) {
+    return "int";
+}
+
+template<>
+const char* type_name<float> (void) {
+    return "float";
+}
+
+template<>
+const char* type_name<double> (void) {
+    return "double";
+}
+
+template<>
+const char* type_name<long double> (void) {
+    return "long_double";
+}
+
+template<typename T, typename F>
+void measure (const char* op, int n, double flops, double bytes, const F& body) {
+    if (!options.filter.empty() && !std::strstr(op, options.filter.c_str())) {
+        return;
+    }
+    typedef std::chrono::steady_clock clock;
+    long long iterations = 1;
+    double elapsed = 0;
+    for (;;) {
+        clock::time_point start = clock::now();
+        for (long long i = 0; i < iterations; ++i) {
+            body();
+        }
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        if (elapsed >= options.min_time || iterations >= (1LL << 40)) {
+            break;
+        }
+        iterations *= 2;
+    }
+    double ns = elapsed * 1E9 / iterations;
+    std::printf("%s,%s,%d,%lld,%.3f,%.4f,%.0f\n", op, type_name<T>(), n, iterations, ns, flops / ns, bytes);
+    std::fflush(stdout);
+}
+
+template<typename T, int n, int m>
+void fill (GenericMatrix<T, n, m>& M, int seed) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < m; ++j) {
+            M[i][j] = (T) ((i * 7 + j * 3 + seed) % 5 - 2) + (i == j ? (T) n : (T) 0);
+        }
+    }
+}
+
+template<typename T, int n>
+void run_decompositions (const SquareMatrix<T, n>& A, std::true_type) {
+    const double s = sizeof(T);
+    const double n2 = (double) n * n;
+    const double n3 = n2 * n;
+    measure<T>("det", n, 2 * n3 / 3, n2 * s, [&] {
+        T D = det(A);
+        keep(D);
+    });
+    measure<T>("inverse", n, 2 * n3, 2 * n2 * s, [&] {
+        SquareMatrix<T, n> R = inverse(A);
+        keep(R);
+    });
+}
+
+template<typename T, int n>
+void run_decompositions (const SquareMatrix<T, n>&, std::false_type) {
+}
+
+template<typename T, int n>
+void run (void) {
+    if (n > options.max_size || (!options.type.empty() && options.type != type_name<T>())) {
+        return;
+    }
+    const int h = n / 2 ? n / 2 : 1;
+    const double s = sizeof(T);
+    const double n2 = (double) n * n;
+    const double n3 = n2 * n;
+
+    SquareMatrix<T, n> A, B;
+    fill<T, n, n>(A, 0);
+    fill<T, n, n>(B, 1);
+    GenericMatrix<T, n, n> C;
+    fill<T, n, n>(C, 2);
+    ColumnMatrix<T, n> u, v;
+    for (int i = 0; i < n; ++i) {
+        u[i] = (T) (i % 7 + 1);
+        v[i] = (T) (i % 5 + 1);
+    }
+
+    measure<T>("mul", n, 2 * n3, 3 * n2 * s, [&] {
+        GenericMatrix<T, n, n> R = A * B;
+        keep(R);
+    });
+    measure<T>("add", n, n2, 3 * n2 * s, [&] {
+        GenericMatrix<T, n, n> R = A + B;
+        keep(R);
+    });
+    measure<T>("transpose", n, 0, 2 * n2 * s, [&] {
+        GenericMatrix<T, n, n> R = transpose(A);
+        keep(R);
+    });
+    run_decompositions(A, std::integral_constant<bool, !std::numeric_limits<T>::is_integer>());
+    measure<T>("conjugate", n, 4 * n3, 3 * n2 * s, [&] {
+        SquareMatrix<T, n> R = conjugate(A, C);
+        keep(R);
+    });
+    measure<T>("sqr", n, n2, (n + n2) * s, [&] {
+        SquareMatrix<T, n> R = sqr(u);
+        keep(R);
+    });
+    measure<T>("dot", n, 2.0 * n, 2.0 * n * s, [&] {
+        T R = dot(u, v);
+        keep(R);
+    });
+    measure<T>("norm", n, 2 * n2, n2 * s, [&] {
+        T R = norm(A);
+        keep(R);
+    });
+    measure<T>("minor", n, 0, 2.0 * h * h * s, [&] {
+        GenericMatrix<T, h, h> R = minor<T, n, n, h, h>(A, 0, 0);
+        keep(R);
+    });
+    GenericMatrix<T, h, h> H = minor<T, n, n, h, h>(A, 0, 0);
+    measure<T>("expand", n, 0, (h * h + n2) * s, [&] {
+        GenericMatrix<T, n, n> R = expand<T, h, h, n, n>(H, 0, 0);
+        keep(R);
+    });
+    measure<T>("cat", n, 0, 4 * n2 * s, [&] {
+        GenericMatrix<T, n, 2 * n> R = cat(A, B);
+        keep(R);
+    });
+    BinaryBuffer buffer;
+    measure<T>("pack", n, 0, n2 * s, [&] {
+        buffer.clear();
+        algorithms::pack(buffer, A.array(), n, n);
+        keep(buffer);
+    });
+    std::ostringstream stream;
+    measure<T>("print", n, 0, n2 * s, [&] {
+        stream.str(std::string());
+        stream << A;
+        keep(stream);
+    });
+    std::vector<char> text(n2 * (algorithms::chars_bound<T>() + 2) + 2 * n + 4);
+    measure<T>("to_chars", n, 0, n2 * s, [&] {
+        char* end = to_chars(text.data(), text.data() + text.size(), A);
+        keep(end);
+    });
+    const char* end = to_chars(text.data(), text.data() + text.size(), A);
+    measure<T>("from_chars", n, 0, n2 * s, [&] {
+        SquareMatrix<T, n> R;
+        const char* last = from_chars(text.data(), end, R);
+        keep(last);
+        keep(R);
+    });
+}
+
+template<typename T>
+void run_sizes (void) {
+    run<T, 2>();
+    run<T, 3>();
+    run<T, 4>();
+    run<T, 8>();
+    run<T, 16>();
+    run<T, 32>();
+    run<T, 64>();
+    run<T, 128>();
+    run<T, 256>();
+    run<T, 512>();
+    run<T, 1024>();
+}
+
+bool option (const char* arg, const char* name, const char*& value) {
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) || arg[len] != '=') {
+        return false;
+    }
+    value = arg + len + 1;
+    return true;
+}
+
+}
+
+int main (int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const char* value;
+        if (option(argv[i], "--filter", value)) {
+            options.filter = value;
+        } else if (option(argv[i], "--type", value)) {
+            options.type = value;
+        } else if (option(argv[i], "--max-size", value)) {
+            options.max_size = std::atoi(value);
+        } else if (option(argv[i], "--min-time", value)) {
+            options.min_time = std::atof(value);
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=op] [--type=int|float|double|long_double] [--max-size=n] [--min-time=seconds]\n", argv[0]);
+            return 1;
+        }
+    }
+    std::printf("op,type,n,iterations,ns_per_op,gflops,bytes_per_op\n");
+    run_sizes<int>();
+    run_sizes<float>();
+    run_sizes<double>();
+    run_sizes<long double>();
+    return 0;
+}
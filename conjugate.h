@@ -3,7 +3,7 @@
 
 #include <GenericMatrix.h>
 #include <SquareMatrix.h>
-#include <transpose.h>
+#include "algorithms.h"
 
 namespace Matrix {
 
@@ -14,10 +14,16 @@ namespace Matrix {
   \param M - сопрягаемая квадратная матрица \a m x \a m
   \param C - сопрягающая матрица \a n x \a m
   \return \a M, умноженная слева на \a C и справа на транспонированную \a C
+
+  Транспонированная \a C не вычисляется; для симметричной \a M вычисляется только верхний треугольник результата.
 */
 template<typename T, int n, int m>
-const SquareMatrix<T, n> conjugate (const SquareMatrix<T, m>& M, const GenericMatrix<T, n, m>& C) {
-    return C * M * transpose(C);
+SquareMatrix<T, n> conjugate (const SquareMatrix<T, m>& M, const GenericMatrix<T, n, m>& C) {
+    algorithms::Scratch<T> CM(n * m);
+    algorithms::fixed::Mul<n, m, m>::run(CM.data(), C.array(), M.array());
+    SquareMatrix<T, n> R;
+    algorithms::mul_transposed(R.array(), CM.data(), C.array(), n, m, n, algorithms::symmetric(M.array(), m));
+    return R;
 }
 
 /*!
@@ -27,10 +33,16 @@ const SquareMatrix<T, n> conjugate (const SquareMatrix<T, m>& M, const GenericMa
   \param M - сопрягаемая квадратная матрица \a m x \a m
   \param C - сопрягающая матрица \a m x \a n
   \return \a M, умноженная слева на транспонированную \a C и справа на \a C
+
+  Транспонированная \a C не вычисляется; для симметричной \a M вычисляется только верхний треугольник результата.
 */
 template<typename T, int n, int m>
-const SquareMatrix<T, n> conjugate_transposed (const SquareMatrix<T, m>& M, const GenericMatrix<T, m, n>& C) {
-    return transpose(C) * M * C;
+SquareMatrix<T, n> conjugate_transposed (const SquareMatrix<T, m>& M, const GenericMatrix<T, m, n>& C) {
+    algorithms::Scratch<T> MC(m * n);
+    algorithms::fixed::Mul<m, m, n>::run(MC.data(), M.array(), C.array());
+    SquareMatrix<T, n> R;
+    algorithms::transposed_mul(R.array(), C.array(), MC.data(), n, m, n, algorithms::symmetric(M.array(), m));
+    return R;
 }
 
 }
@@ -0,0 +1,36 @@
+#ifndef _MATRIX_CONSTEXPR_H
+#define _MATRIX_CONSTEXPR_H
+
+#include <type_traits>
+
+/*! \def USE_CONSTEXPR
+  Вычисление матриц во время компиляции: конструкторы, арифметика, транспонирование, определитель
+  и обратная матрица объявляются constexpr. Требует C++20 (неинициализированные элементы
+  в constexpr-конструкторах и std::is_constant_evaluated), в более ранних стандартах отключается.
+*/
+
+#ifndef USE_CONSTEXPR
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201907L && defined(__cpp_lib_is_constant_evaluated)
+#define USE_CONSTEXPR 1
+#else
+#define USE_CONSTEXPR 0
+#endif
+#endif
+
+/*! \def MATRIX_CONSTEXPR
+  спецификатор constexpr, если вычисление во время компиляции доступно
+*/
+
+/*! \def MATRIX_CONSTANT_EVALUATED
+  признак вычисления во время компиляции: векторные и блочные ядра в этом случае не используются
+*/
+
+#if USE_CONSTEXPR
+#define MATRIX_CONSTEXPR constexpr
+#define MATRIX_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#else
+#define MATRIX_CONSTEXPR
+#define MATRIX_CONSTANT_EVALUATED() false
+#endif
+
+#endif
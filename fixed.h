@@ -0,0 +1,270 @@
+#ifndef _MATRIX_FIXED_H
+#define _MATRIX_FIXED_H
+
+#include "algorithms.h"
+
+namespace Matrix {
+
+namespace algorithms {
+
+/*! \namespace fixed
+  Операции над матрицами с размерами не более 4, развернутые во время компиляции,
+  и явные формулы определителя и обратной матрицы для матриц 1 x 1 - 4 x 4
+*/
+namespace fixed {
+
+/*!
+  наибольший размер матриц, для которых операции разворачиваются
+*/
+enum {size = 4};
+
+/*! \class Dot
+  \brief развернутое скалярное произведение строки \a lhs и столбца \a rhs матрицы с \a m столбцами
+  \tparam k - количество слагаемых
+  \tparam m - расстояние между соседними элементами столбца \a rhs
+*/
+template<int k, int m>
+struct Dot {
+    template<typename T>
+    static MATRIX_CONSTEXPR T run (const T* lhs, const T* rhs) {
+        return Dot<k - 1, m>::run(lhs, rhs) + lhs[k - 1] * rhs[(k - 1) * m];
+    }
+};
+
+template<int m>
+struct Dot<1, m> {
+    template<typename T>
+    static MATRIX_CONSTEXPR T run (const T* lhs, const T* rhs) {
+        return lhs[0] * rhs[0];
+    }
+};
+
+/*! \class Mul
+  \brief умножение матриц \a n x \a k и \a k x \a m, развернутое для размеров не более \a size
+*/
+template<int n, int k, int m, bool unrolled = (n <= size && k <= size && m <= size)>
+struct Mul {
+    template<typename T>
+    static MATRIX_CONSTEXPR void run (T* dst, const T* lhs, const T* rhs) {
+        mul(dst, lhs, rhs, n, k, m);
+    }
+};
+
+template<int n, int k, int m>
+struct Mul<n, k, m, true> {
+    template<typename T>
+    static MATRIX_CONSTEXPR void run (T* dst, const T* lhs, const T* rhs) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < m; ++j) {
+                dst[i * m + j] = Dot<k, m>::run(lhs + i * k, rhs + j);
+            }
+        }
+    }
+};
+
+/*! \class Transpose
+  \brief транспонирование матрицы \a n x \a m, развернутое для размеров не более \a size
+*/
+template<int n, int m, bool unrolled = (n <= size && m <= size)>
+struct Transpose {
+    template<typename T>
+    static MATRIX_CONSTEXPR void run (T* dst, const T* src) {
+        transpose(dst, src, n, m);
+    }
+};
+
+template<int n, int m>
+struct Transpose<n, m, true> {
+    template<typename T>
+    static MATRIX_CONSTEXPR void run (T* dst, const T* src) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < m; ++j) {
+                dst[j * n + i] = src[i * m + j];
+            }
+        }
+    }
+};
+
+template<typename T>
+MATRIX_CONSTEXPR T det2 (const T* a) {
+    return a[0] * a[3] - a[1] * a[2];
+}
+
+template<typename T>
+MATRIX_CONSTEXPR T det3 (const T* a) {
+    return a[0] * (a[4] * a[8] - a[5] * a[7])
+         - a[1] * (a[3] * a[8] - a[5] * a[6])
+         + a[2] * (a[3] * a[7] - a[4] * a[6]);
+}
+
+template<typename T>
+MATRIX_CONSTEXPR T det4 (const T* a) {
+    T s0 = a[0] * a[5] - a[4] * a[1];
+    T s1 = a[0] * a[6] - a[4] * a[2];
+    T s2 = a[0] * a[7] - a[4] * a[3];
+    T s3 = a[1] * a[6] - a[5] * a[2];
+    T s4 = a[1] * a[7] - a[5] * a[3];
+    T s5 = a[2] * a[7] - a[6] * a[3];
+    T c5 = a[10] * a[15] - a[14] * a[11];
+    T c4 = a[9] * a[15] - a[13] * a[11];
+    T c3 = a[9] * a[14] - a[13] * a[10];
+    T c2 = a[8] * a[15] - a[12] * a[11];
+    T c1 = a[8] * a[14] - a[12] * a[10];
+    T c0 = a[8] * a[13] - a[12] * a[9];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+/*!
+  определитель матрицы по явной формуле
+  \param array - матрица \a n x \a n, \a n не более \a size
+  \return определитель матрицы
+*/
+template<typename T>
+MATRIX_CONSTEXPR T det (const T* array, int n) {
+    switch (n) {
+    case 1:
+        return array[0];
+    case 2:
+        return det2(array);
+    case 3:
+        return det3(array);
+    default:
+        return det4(array);
+    }
+}
+
+/*!
+  проверка вырожденности матрицы по ее определителю, вычисленному по явной формуле
+  \param array - матрица \a n x \a n, \a n не более \a size
+  \param D - определитель матрицы
+  \return \a true, если определитель равен нулю или (для чисел с плавающей точкой) его отношение
+  к произведению сумм модулей элементов строк (не меньшему модуля определителя) не превышает precision
+*/
+template<typename T>
+MATRIX_CONSTEXPR bool singular (const T* array, const T& D, int n) {
+    if (D == 0) {
+        return true;
+    }
+    if (precision<T>() == 0) {
+        return false;
+    }
+    T ratio = abs(D);
+    for (int i = 0; i < n; ++i) {
+        T norm = 0;
+        for (int j = 0; j < n; ++j) {
+            norm += abs(array[i * n + j]);
+        }
+        ratio /= norm;
+    }
+    return ratio <= precision<T>();
+}
+
+template<typename T>
+MATRIX_CONSTEXPR T inverse1 (T* inverse, const T* a) {
+    T D = a[0];
+    if (singular(a, D, 1)) {
+        return 0;
+    }
+    inverse[0] = 1 / D;
+    return D;
+}
+
+template<typename T>
+MATRIX_CONSTEXPR T inverse2 (T* inverse, const T* a) {
+    T D = det2(a);
+    if (singular(a, D, 2)) {
+        return 0;
+    }
+    T b = 1 / D;
+    T R[4] = {a[3] * b, -a[1] * b, -a[2] * b, a[0] * b};
+    cp(inverse, R, 4);
+    return D;
+}
+
+template<typename T>
+MATRIX_CONSTEXPR T inverse3 (T* inverse, const T* a) {
+    T c0 = a[4] * a[8] - a[5] * a[7];
+    T c1 = a[5] * a[6] - a[3] * a[8];
+    T c2 = a[3] * a[7] - a[4] * a[6];
+    T D = a[0] * c0 + a[1] * c1 + a[2] * c2;
+    if (singular(a, D, 3)) {
+        return 0;
+    }
+    T b = 1 / D;
+    T R[9] = {
+        c0 * b, (a[2] * a[7] - a[1] * a[8]) * b, (a[1] * a[5] - a[2] * a[4]) * b,
+        c1 * b, (a[0] * a[8] - a[2] * a[6]) * b, (a[2] * a[3] - a[0] * a[5]) * b,
+        c2 * b, (a[1] * a[6] - a[0] * a[7]) * b, (a[0] * a[4] - a[1] * a[3]) * b
+    };
+    cp(inverse, R, 9);
+    return D;
+}
+
+template<typename T>
+MATRIX_CONSTEXPR T inverse4 (T* inverse, const T* a) {
+    T s0 = a[0] * a[5] - a[4] * a[1];
+    T s1 = a[0] * a[6] - a[4] * a[2];
+    T s2 = a[0] * a[7] - a[4] * a[3];
+    T s3 = a[1] * a[6] - a[5] * a[2];
+    T s4 = a[1] * a[7] - a[5] * a[3];
+    T s5 = a[2] * a[7] - a[6] * a[3];
+    T c5 = a[10] * a[15] - a[14] * a[11];
+    T c4 = a[9] * a[15] - a[13] * a[11];
+    T c3 = a[9] * a[14] - a[13] * a[10];
+    T c2 = a[8] * a[15] - a[12] * a[11];
+    T c1 = a[8] * a[14] - a[12] * a[10];
+    T c0 = a[8] * a[13] - a[12] * a[9];
+    T D = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (singular(a, D, 4)) {
+        return 0;
+    }
+    T b = 1 / D;
+    T R[16] = {
+        ( a[5] * c5 - a[6] * c4 + a[7] * c3) * b,
+        (-a[1] * c5 + a[2] * c4 - a[3] * c3) * b,
+        ( a[13] * s5 - a[14] * s4 + a[15] * s3) * b,
+        (-a[9] * s5 + a[10] * s4 - a[11] * s3) * b,
+        (-a[4] * c5 + a[6] * c2 - a[7] * c1) * b,
+        ( a[0] * c5 - a[2] * c2 + a[3] * c1) * b,
+        (-a[12] * s5 + a[14] * s2 - a[15] * s1) * b,
+        ( a[8] * s5 - a[10] * s2 + a[11] * s1) * b,
+        ( a[4] * c4 - a[5] * c2 + a[7] * c0) * b,
+        (-a[0] * c4 + a[1] * c2 - a[3] * c0) * b,
+        ( a[12] * s4 - a[13] * s2 + a[15] * s0) * b,
+        (-a[8] * s4 + a[9] * s2 - a[11] * s0) * b,
+        (-a[4] * c3 + a[5] * c1 - a[6] * c0) * b,
+        ( a[0] * c3 - a[1] * c1 + a[2] * c0) * b,
+        (-a[12] * s3 + a[13] * s1 - a[14] * s0) * b,
+        ( a[8] * s3 - a[9] * s1 + a[10] * s0) * b
+    };
+    cp(inverse, R, 16);
+    return D;
+}
+
+/*!
+  определитель и обратная матрица по явным формулам
+  \param inverse - обратная матрица (не меняется, если матрица вырождена)
+  \param array - матрица \a n x \a n, \a n не более \a size (может совпадать с \a inverse)
+  \return определитель матрицы (0, если матрица вырождена в смысле singular)
+*/
+template<typename T>
+MATRIX_CONSTEXPR T inverse (T* inverse, const T* array, int n) {
+    switch (n) {
+    case 1:
+        return inverse1(inverse, array);
+    case 2:
+        return inverse2(inverse, array);
+    case 3:
+        return inverse3(inverse, array);
+    default:
+        return inverse4(inverse, array);
+    }
+}
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef _MATRIX_FORMAT_H
+#define _MATRIX_FORMAT_H
+
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <GenericMatrix.h>
+#include "algorithms.h"
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+/*! \def USE_TO_CHARS
+  Форматирование и разбор чисел функциями std::to_chars/std::from_chars (C++17, включая числа
+  с плавающей точкой). Без них используются snprintf и strtod с max_digits10 значащими цифрами.
+  Оба способа не зависят от локали и восстанавливают числа точно: без std::to_chars десятичный
+  разделитель текущей локали C (LC_NUMERIC) заменяется точкой при записи и обратно при разборе.
+*/
+
+#ifndef USE_TO_CHARS
+#if defined(__cpp_lib_to_chars)
+#define USE_TO_CHARS 1
+#else
+#define USE_TO_CHARS 0
+#endif
+#endif
+
+namespace Matrix {
+
+namespace algorithms {
+
+/*!
+  наибольшая длина записи числа
+  \tparam T - числовой тип
+  \return количество символов, достаточное для записи любого числа типа \a T
+*/
+template<typename T>
+inline int chars_bound (void) {
+    return std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::digits10 + 3 : std::numeric_limits<T>::max_digits10 + 12;
+}
+
+#if !USE_TO_CHARS
+inline int snprint (char* buffer, int size, int x) {
+    return std::snprintf(buffer, size, "%d", x);
+}
+
+inline int snprint (char* buffer, int size, float x) {
+    return std::snprintf(buffer, size, "%.*g", std::numeric_limits<float>::max_digits10, x);
+}
+
+inline int snprint (char* buffer, int size, double x) {
+    return std::snprintf(buffer, size, "%.*g", std::numeric_limits<double>::max_digits10, x);
+}
+
+inline int snprint (char* buffer, int size, long double x) {
+    return std::snprintf(buffer, size, "%.*Lg", std::numeric_limits<long double>::max_digits10, x);
+}
+
+inline void strto (const char* buffer, char** end, int& x) {
+    x = std::strtol(buffer, end, 10);
+}
+
+inline void strto (const char* buffer, char** end, float& x) {
+    x = std::strtof(buffer, end);
+}
+
+inline void strto (const char* buffer, char** end, double& x) {
+    x = std::strtod(buffer, end);
+}
+
+inline void strto (const char* buffer, char** end, long double& x) {
+    x = std::strtold(buffer, end);
+}
+
+/*!
+  десятичный разделитель текущей локали C
+*/
+inline const char* decimal_point (void) {
+    const char* point = std::localeconv()->decimal_point;
+    return point && *point ? point : ".";
+}
+#endif
+
+inline char* format_text (char* first, char* last, const char* text, int cnt) {
+    if (!first || cnt > last - first) {
+        return nullptr;
+    }
+    cp(first, text, cnt);
+    return first + cnt;
+}
+
+inline bool space (char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+inline const char* skip_space (const char* first, const char* last) {
+    while (first && first < last && space(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+inline const char* parse_char (const char* first, const char* last, char c) {
+    first = skip_space(first, last);
+    return first && first < last && *first == c ? first + 1 : nullptr;
+}
+
+/*!
+  запись числа в буфер
+  \param first - начало буфера
+  \param last - конец буфера
+  \param x - число
+  \return указатель за записанным числом (нулевой указатель, если буфер мал)
+*/
+template<typename T>
+char* format_item (char* first, char* last, const T& x) {
+#if USE_TO_CHARS
+    std::to_chars_result result = std::to_chars(first, last, x);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+    char buffer[64];
+    int cnt = snprint(buffer, sizeof(buffer), x);
+    if (cnt < 0 || cnt >= (int) sizeof(buffer)) {
+        return nullptr;
+    }
+    const char* point = decimal_point();
+    int len = std::strlen(point);
+    if (std::strcmp(point, ".")) {
+        char* found = std::strstr(buffer, point);
+        if (found) {
+            *found = '.';
+            std::memmove(found + 1, found + len, buffer + cnt + 1 - (found + len));
+            cnt -= len - 1;
+        }
+    }
+    if (cnt > last - first) {
+        return nullptr;
+    }
+    cp(first, buffer, cnt);
+    return first + cnt;
+#endif
+}
+
+/*!
+  разбор числа из буфера
+  \param first - начало буфера
+  \param last - конец буфера
+  \param x - ссылка на число
+  \return указатель за разобранным числом (нулевой указатель в случае ошибки)
+*/
+template<typename T>
+const char* parse_item (const char* first, const char* last, T& x) {
+#if USE_TO_CHARS
+    std::from_chars_result result = std::from_chars(first, last, x);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+    const char* point = decimal_point();
+    int len = std::strlen(point);
+    char buffer[64];
+    int cnt = 0;
+    int dot = -1;
+    int size = 0;
+    while (first + cnt < last && size + len < (int) sizeof(buffer) && first[cnt] != ',' && first[cnt] != '}' && !space(first[cnt])) {
+        if (first[cnt] == '.' && dot < 0) {
+            dot = size;
+            cp(buffer + size, point, len);
+            size += len;
+        } else {
+            buffer[size++] = first[cnt];
+        }
+        ++cnt;
+    }
+    buffer[size] = 0;
+    char* end;
+    strto(buffer, &end, x);
+    int parsed = end - buffer;
+    if (dot >= 0 && parsed > dot) {
+        parsed -= len - 1;
+    }
+    return parsed == 0 ? nullptr : first + parsed;
+#endif
+}
+
+/*!
+  запись матрицы в буфер в текстовом виде {{a, b}, {c, d}}, как print
+  \param first - начало буфера
+  \param last - конец буфера
+  \param array - матрица \a n x \a m
+  \return указатель за записанной матрицей (нулевой указатель, если буфер мал)
+*/
+template<typename T>
+char* format (char* first, char* last, const T* array, int n, int m) {
+    const T* _array = array;
+    first = format_text(first, last, "{", 1);
+    int i = n;
+    while (i--) {
+        first = format_text(first, last, "{", 1);
+        int j = m;
+        while (j--) {
+            first = first ? format_item(first, last, *_array++) : nullptr;
+            if (j) {
+                first = format_text(first, last, ", ", 2);
+            }
+        }
+        first = format_text(first, last, "}", 1);
+#if LINEBREAK
+        first = format_text(first, last, "\n", 1);
+#endif
+        if (i) {
+            first = format_text(first, last, ", ", 2);
+        }
+    }
+    first = format_text(first, last, "}", 1);
+#if LINEBREAK
+    first = format_text(first, last, "\n", 1);
+#endif
+    return first;
+}
+
+/*!
+  разбор матрицы из буфера в текстовом виде {{a, b}, {c, d}} (пробельные символы между числами и скобками допускаются)
+  \param first - начало буфера
+  \param last - конец буфера
+  \param array - матрица \a n x \a m
+  \return указатель за закрывающей скобкой (нулевой указатель в случае ошибки или несоответствия размеров)
+*/
+template<typename T>
+const char* parse (const char* first, const char* last, T* array, int n, int m) {
+    T* _array = array;
+    first = parse_char(first, last, '{');
+    for (int i = 0; i < n; ++i) {
+        first = parse_char(first, last, '{');
+        for (int j = 0; j < m; ++j) {
+            first = skip_space(first, last);
+            first = first ? parse_item(first, last, *_array++) : nullptr;
+            if (j + 1 < m) {
+                first = parse_char(first, last, ',');
+            }
+        }
+        first = parse_char(first, last, '}');
+        if (i + 1 < n) {
+            first = parse_char(first, last, ',');
+        }
+    }
+    return parse_char(first, last, '}');
+}
+
+}
+
+/*! \relates GenericMatrix
+  запись матрицы в буфер в текстовом виде {{a, b}, {c, d}} без потоков и локали
+  \param first - начало буфера
+  \param last - конец буфера
+  \param M - матрица
+  \return указатель за записанной матрицей (нулевой указатель, если буфер мал)
+*/
+template<typename T, int n, int m, typename S>
+char* to_chars (char* first, char* last, const GenericMatrix<T, n, m, S>& M) {
+    return algorithms::format(first, last, M.array(), n, m);
+}
+
+/*! \relates GenericMatrix
+  разбор матрицы из буфера в текстовом виде {{a, b}, {c, d}}
+  \param first - начало буфера
+  \param last - конец буфера
+  \param M - ссылка на матрицу
+  \return указатель за разобранной матрицей (нулевой указатель в случае ошибки, \a M при этом не определена)
+*/
+template<typename T, int n, int m, typename S>
+const char* from_chars (const char* first, const char* last, GenericMatrix<T, n, m, S>& M) {
+    return algorithms::parse(first, last, M.array(), n, m);
+}
+
+/*! \relates GenericMatrix
+  текстовая запись матрицы {{a, b}, {c, d}}
+  \param M - матрица
+  \return строка, из которой from_chars восстанавливает \a M точно (пустая, если запись не удалась)
+*/
+template<typename T, int n, int m, typename S>
+std::string to_string (const GenericMatrix<T, n, m, S>& M) {
+    std::string R(n * m * (algorithms::chars_bound<T>() + 2) + 2 * n + 4, ' ');
+    char* end = to_chars(&R[0], &R[0] + R.size(), M);
+    R.resize(end ? end - &R[0] : 0);
+    return R;
+}
+
+}
+
+#endif
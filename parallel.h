@@ -0,0 +1,304 @@
+#ifndef _MATRIX_PARALLEL_H
+#define _MATRIX_PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "constexpr.h"
+
+/*! \def MATRIX_THREADS
+  Количество потоков (включая вызывающий), на которые по умолчанию распределяются блочное умножение
+  и исключение Гаусса; при значении 1 вычисления однопоточные. Меняется во время выполнения функцией parallel::threads.
+*/
+
+#ifndef MATRIX_THREADS
+#define MATRIX_THREADS 1
+#endif
+
+/*! \def PARALLEL_THRESHOLD
+  Минимальное количество операций умножения-сложения, начиная с которого цикл распределяется по потокам
+*/
+
+#ifndef PARALLEL_THRESHOLD
+#define PARALLEL_THRESHOLD (64 * 1024)
+#endif
+
+namespace Matrix {
+
+namespace algorithms {
+
+/*! \namespace parallel
+  Пул потоков с перехватом задач для распределения независимых итераций циклов. Каждая итерация
+  выполняется одним потоком целиком, поэтому результат не зависит от количества потоков и порядка выполнения задач.
+*/
+namespace parallel {
+
+/*! \class Pool
+  \brief пул потоков с перехватом задач: у каждого потока своя очередь, свободный поток забирает задачи из чужих очередей
+*/
+class Pool {
+    struct Job {
+        void (*invoke)(const void*, int, int);
+        const void* body;
+        std::atomic<int> remaining;
+    };
+
+    struct Task {
+        Job* job;
+        int begin;
+        int end;
+    };
+
+/*
+  очередь задач потока: владелец берет задачи с конца, остальные потоки - с начала
+*/
+    struct Queue {
+        std::mutex mutex;
+        std::vector<Task> ring;
+        std::size_t head;
+        std::size_t count;
+
+        Queue (void) : ring(16), head(0), count(0) {
+        }
+
+        void push (const Task& task) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (count == ring.size()) {
+                std::vector<Task> grown(2 * ring.size());
+                for (std::size_t i = 0; i < count; ++i) {
+                    grown[i] = ring[(head + i) % ring.size()];
+                }
+                ring.swap(grown);
+                head = 0;
+            }
+            ring[(head + count++) % ring.size()] = task;
+        }
+
+        bool pop (Task& task, bool own) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!count) {
+                return false;
+            }
+            if (own) {
+                task = ring[(head + --count) % ring.size()];
+            } else {
+                task = ring[head];
+                head = (head + 1) % ring.size();
+                --count;
+            }
+            return true;
+        }
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::atomic<int> m_queued;
+    bool m_stop;
+
+    static int& index (void) {
+        static thread_local int I = -1;
+        return I;
+    }
+
+    bool take (Task& task, int self) {
+        int cnt = (int) m_queues.size();
+        for (int i = 0; i < cnt; ++i) {
+            int q = (self + i) % cnt;
+            if (m_queues[q]->pop(task, i == 0)) {
+                --m_queued;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void execute (const Task& task) {
+        task.job->invoke(task.job->body, task.begin, task.end);
+        task.job->remaining.fetch_sub(1, std::memory_order_release);
+    }
+
+    void work (int self) {
+        index() = self;
+        Task task;
+        for (;;) {
+            if (take(task, self)) {
+                execute(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] {
+                return m_stop || m_queued.load() > 0;
+            });
+            if (m_stop) {
+                return;
+            }
+        }
+    }
+
+    void start (int threads) {
+        m_stop = false;
+        m_queues.clear();
+        for (int i = 0; i < threads; ++i) {
+            m_queues.emplace_back(new Queue);
+        }
+        for (int i = 1; i < threads; ++i) {
+            m_threads.emplace_back(&Pool::work, this, i);
+        }
+    }
+
+    void stop (void) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::size_t i = 0; i < m_threads.size(); ++i) {
+            m_threads[i].join();
+        }
+        m_threads.clear();
+    }
+
+    template<typename F>
+    static void invoke (const void* body, int begin, int end) {
+        (*static_cast<const F*>(body))(begin, end);
+    }
+
+public:
+/*!
+  \param threads - количество потоков, включая вызывающий
+*/
+    explicit Pool (int threads) : m_queued(0), m_stop(false) {
+        start(threads < 1 ? 1 : threads);
+    }
+
+    ~Pool (void) {
+        stop();
+    }
+
+    Pool (const Pool&) = delete;
+    Pool& operator = (const Pool&) = delete;
+
+/*!
+  количество потоков пула, включая вызывающий
+*/
+    int threads (void) const {
+        return (int) m_queues.size();
+    }
+
+/*!
+  изменение количества потоков (не должно вызываться во время выполнения задач пула)
+  \param threads - количество потоков, включая вызывающий
+*/
+    void resize (int threads) {
+        if (threads < 1) {
+            threads = 1;
+        }
+        if (threads != this->threads()) {
+            stop();
+            start(threads);
+        }
+    }
+
+/*!
+  распределенное выполнение цикла: диапазон делится на \a chunks частей, вызывающий поток участвует в вычислениях.
+  Вложенный вызов (из задачи пула) выполняется последовательно в текущем потоке.
+  \param begin - начало диапазона итераций
+  \param end - конец диапазона итераций
+  \param chunks - количество задач
+  \param body - функция body(b, e), выполняющая итерации [b, e)
+*/
+    template<typename F>
+    void run (int begin, int end, int chunks, const F& body) {
+        int cnt = end - begin;
+        if (chunks > cnt) {
+            chunks = cnt;
+        }
+        if (chunks <= 1 || threads() == 1 || index() >= 0) {
+            if (cnt > 0) {
+                body(begin, end);
+            }
+            return;
+        }
+        Job job;
+        job.invoke = &Pool::invoke<F>;
+        job.body = &body;
+        job.remaining = chunks;
+        for (int c = chunks - 1; c >= 0; --c) {
+            Task task = {&job, begin + (int) ((long long) cnt * c / chunks), begin + (int) ((long long) cnt * (c + 1) / chunks)};
+            m_queues[c % threads()]->push(task);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queued += chunks;
+        }
+        m_wake.notify_all();
+        index() = 0;
+        Task task;
+        while (job.remaining.load(std::memory_order_acquire) > 0) {
+            if (take(task, 0)) {
+                execute(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        index() = -1;
+    }
+};
+
+/*!
+  общий пул потоков (создается при первом обращении с MATRIX_THREADS потоками)
+*/
+inline Pool& pool (void) {
+    static Pool P(MATRIX_THREADS);
+    return P;
+}
+
+/*!
+  количество потоков, на которые распределяются вычисления
+*/
+inline int threads (void) {
+    return pool().threads();
+}
+
+/*!
+  изменение количества потоков, на которые распределяются вычисления (не во время вычислений)
+  \param cnt - количество потоков, включая вызывающий
+*/
+inline void threads (int cnt) {
+    pool().resize(cnt);
+}
+
+/*!
+  распределение независимых итераций цикла по потокам общего пула
+  (последовательно при вычислении во время компиляции и при малом объеме работы)
+  \param begin - начало диапазона итераций
+  \param end - конец диапазона итераций
+  \param cost - количество операций умножения-сложения в одной итерации
+  \param body - функция body(b, e), выполняющая итерации [b, e)
+*/
+template<typename F>
+MATRIX_CONSTEXPR void run (int begin, int end, long long cost, const F& body) {
+    if (MATRIX_CONSTANT_EVALUATED() || cost * (end - begin) < PARALLEL_THRESHOLD || threads() == 1) {
+        if (end > begin) {
+            body(begin, end);
+        }
+        return;
+    }
+    long long chunks = cost * (end - begin) / (PARALLEL_THRESHOLD / 4);
+    int limit = 4 * threads();
+    pool().run(begin, end, chunks < limit ? (int) chunks : limit, body);
+}
+
+}
+
+}
+
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef _MATRIX_PRECISION_H
 #define _MATRIX_PRECISION_H
 
+#include "constexpr.h"
+
 namespace Matrix {
 
 /*!
@@ -9,25 +11,25 @@ namespace Matrix {
   \return малое неотрицательное число, превышение которого необходимо, чтобы число считалось ненулевым при вычислениях
 */
 template<typename T>
-inline T precision (void);
+inline MATRIX_CONSTEXPR T precision (void);
 
 template<>
-inline int precision (void) {
+inline MATRIX_CONSTEXPR int precision (void) {
     return 0;
 }
 
 template<>
-inline float precision (void) {
+inline MATRIX_CONSTEXPR float precision (void) {
     return 1E-6;
 }
 
 template<>
-inline double precision (void) {
+inline MATRIX_CONSTEXPR double precision (void) {
     return 1E-12;
 }
 
 template<>
-inline long double precision (void) {
+inline MATRIX_CONSTEXPR long double precision (void) {
     return 1E-15;
 }
 
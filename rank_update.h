@@ -0,0 +1,158 @@
+#ifndef _MATRIX_RANK_UPDATE_H
+#define _MATRIX_RANK_UPDATE_H
+
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include <ColumnMatrix.h>
+#include <SymmetricMatrix.h>
+#include "algorithms.h"
+
+namespace Matrix {
+
+/*! \enum triangle_t
+  обновляемая часть квадратной матрицы: вся матрица, верхний (с диагональю) или нижний (с диагональю) треугольник
+*/
+typedef enum {FULL = 0, UPPER, LOWER} triangle_t;
+
+namespace algorithms {
+
+/*!
+  обновление ранга 1: \a dst += \a alpha * \a v * транспонированный \a v
+  \param dst - матрица \a n x \a n
+  \param v - вектор длины \a n
+  \param triangle - обновляемая часть \a dst
+
+  Элементы (i, j) и (j, i) вычисляются одинаково, симметричная матрица остается точно симметричной.
+*/
+template<typename T>
+MATRIX_CONSTEXPR void syr (T* dst, const T* v, T alpha, int n, triangle_t triangle) {
+    for (int i = 0; i < n; ++i) {
+        T vi = v[i];
+        int j0 = triangle == UPPER ? i : 0;
+        int j1 = triangle == LOWER ? i + 1 : n;
+        T* row = dst + i * n;
+        for (int j = j0; j < j1; ++j) {
+            row[j] += alpha * (vi * v[j]);
+        }
+    }
+}
+
+/*!
+  обновление ранга k: \a dst += \a alpha * \a V * транспонированная \a V
+  \param dst - матрица \a n x \a n
+  \param V - матрица \a n x \a k
+  \param triangle - обновляемая часть \a dst
+
+  Вычисляются скалярные произведения строк \a V для одного треугольника, для FULL они отражаются.
+*/
+template<typename T>
+MATRIX_CONSTEXPR void syrk (T* dst, const T* V, T alpha, int n, int k, triangle_t triangle) {
+    parallel::run(0, n, (long long) n * k / 2, [=] (int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const T* row_i = V + i * k;
+            for (int j = i; j < n; ++j) {
+                T S = alpha * dot(row_i, V + j * k, k);
+                if (triangle != LOWER) {
+                    dst[i * n + j] += S;
+                }
+                if (triangle == LOWER || (triangle == FULL && j != i)) {
+                    dst[j * n + i] += S;
+                }
+            }
+        }
+    });
+}
+
+/*!
+  обновление ранга 1 симметричной матрицы, хранящей верхний треугольник построчно
+  \param dst - массив n * (n + 1) / 2 элементов
+  \param v - вектор длины \a n
+*/
+template<typename T>
+void sym_syr (T* dst, const T* v, T alpha, int n) {
+    T* _dst = dst;
+    for (int i = 0; i < n; ++i) {
+        T vi = v[i];
+        for (int j = i; j < n; ++j) {
+            *_dst++ += alpha * (vi * v[j]);
+        }
+    }
+}
+
+/*!
+  обновление ранга k симметричной матрицы, хранящей верхний треугольник построчно
+  \param dst - массив n * (n + 1) / 2 элементов
+  \param V - матрица \a n x \a k
+*/
+template<typename T>
+void sym_syrk (T* dst, const T* V, T alpha, int n, int k) {
+    T* _dst = dst;
+    for (int i = 0; i < n; ++i) {
+        const T* row_i = V + i * k;
+        for (int j = i; j < n; ++j) {
+            *_dst++ += alpha * dot(row_i, V + j * k, k);
+        }
+    }
+}
+
+}
+
+/*! \relates SquareMatrix
+  обновление ранга 1 на месте, без промежуточных матриц: \a P += \a alpha * \a v * транспонированный \a v
+  \param P - обновляемая квадратная матрица
+  \param v - матрица-столбец
+  \param alpha - множитель
+  \param triangle - обновляемая часть \a P (FULL - вся матрица)
+  \return ссылка на \a P
+*/
+template<typename T, int n>
+MATRIX_CONSTEXPR SquareMatrix<T, n>& rank1_update (SquareMatrix<T, n>& P, const ColumnMatrix<T, n>& v, const T& alpha = 1, triangle_t triangle = FULL) {
+    algorithms::syr(P.array(), v.array(), alpha, n, triangle);
+    return P;
+}
+
+/*! \relates SquareMatrix
+  обновление ранга k на месте, без промежуточных матриц: \a P += \a alpha * \a V * транспонированная \a V
+  \tparam k - количество столбцов (векторов) в \a V
+  \param P - обновляемая квадратная матрица
+  \param V - матрица \a n x \a k
+  \param alpha - множитель
+  \param triangle - обновляемая часть \a P (FULL - вся матрица)
+  \return ссылка на \a P
+*/
+template<typename T, int n, int k, typename S>
+MATRIX_CONSTEXPR SquareMatrix<T, n>& rank_k_update (SquareMatrix<T, n>& P, const GenericMatrix<T, n, k, S>& V, const T& alpha = 1, triangle_t triangle = FULL) {
+    algorithms::syrk(P.array(), V.array(), alpha, n, k, triangle);
+    return P;
+}
+
+/*! \relates SymmetricMatrix
+  обновление ранга 1 на месте (обновляется только хранимый верхний треугольник)
+  \param P - обновляемая симметричная матрица
+  \param v - матрица-столбец
+  \param alpha - множитель
+  \return ссылка на \a P
+*/
+template<typename T, int n>
+SymmetricMatrix<T, n>& rank1_update (SymmetricMatrix<T, n>& P, const ColumnMatrix<T, n>& v, const T& alpha = 1) {
+    algorithms::sym_syr(P.array(), v.array(), alpha, n);
+    return P;
+}
+
+/*! \relates SymmetricMatrix
+  обновление ранга k на месте (обновляется только хранимый верхний треугольник)
+  \tparam k - количество столбцов (векторов) в \a V
+  \param P - обновляемая симметричная матрица
+  \param V - матрица \a n x \a k
+  \param alpha - множитель
+  \return ссылка на \a P
+*/
+template<typename T, int n, int k, typename S>
+SymmetricMatrix<T, n>& rank_k_update (SymmetricMatrix<T, n>& P, const GenericMatrix<T, n, k, S>& V, const T& alpha = 1) {
+    algorithms::sym_syrk(P.array(), V.array(), alpha, n, k);
+    return P;
+}
+
+}
+
+#endif
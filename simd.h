@@ -0,0 +1,322 @@
+#ifndef _MATRIX_SIMD_H
+#define _MATRIX_SIMD_H
+
+/*! \def USE_SIMD
+  Использование векторных инструкций SSE2/AVX2/AVX-512 для поэлементных операций над
+  массивами float и double. Набор инструкций выбирается во время выполнения по возможностям процессора.
+*/
+
+#ifndef USE_SIMD
+#define USE_SIMD 1
+#endif
+
+#if USE_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+namespace Matrix {
+
+namespace algorithms {
+
+namespace simd {
+
+/*! \enum level_t
+  набор векторных инструкций, используемый поэлементными операциями
+*/
+typedef enum {SCALAR = 0, SSE2, AVX2, AVX512} level_t;
+
+/*!
+  определение набора векторных инструкций, поддерживаемого процессором
+  \return наилучший доступный набор инструкций
+*/
+inline level_t detect (void) {
+#if SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SSE2;
+    }
+#endif
+    return SCALAR;
+}
+
+/*!
+  набор векторных инструкций текущего процессора (определяется при первом вызове)
+*/
+inline level_t level (void) {
+    static const level_t L = detect();
+    return L;
+}
+
+/*
+  Обобщенные варианты для типов без векторной реализации: возвращают false,
+  и вызывающая сторона использует скалярный цикл.
+*/
+
+template<typename T>
+inline bool add (T*, const T*, int) {
+    return false;
+}
+
+template<typename T>
+inline bool sub (T*, const T*, int) {
+    return false;
+}
+
+template<typename T>
+inline bool mul (T*, T, int) {
+    return false;
+}
+
+template<typename T>
+inline bool null (T*, int) {
+    return false;
+}
+
+template<typename T>
+inline bool dot (T&, const T*, const T*, int) {
+    return false;
+}
+
+template<typename T>
+inline bool norm (T&, const T*, int) {
+    return false;
+}
+
+template<typename T>
+inline bool cmp (bool&, const T*, const T*, int) {
+    return false;
+}
+
+#if SIMD_X86
+
+/*
+  Ядра поэлементных операций порождаются макросом для каждой пары (набор инструкций, тип элементов).
+  Хвост массива, не кратный ширине вектора, обрабатывается скалярно.
+*/
+
+#define SIMD_KERNELS(ISA, T, V, W, LOAD, STORE, ADD, SUB, MUL, SET1, ZERO, NEQ, SUM) \
+__attribute__((target(ISA))) inline void add (T* lhs, const T* rhs, int cnt) { \
+    int i = 0; \
+    for (; i + W <= cnt; i += W) { \
+        STORE(lhs + i, ADD(LOAD(lhs + i), LOAD(rhs + i))); \
+    } \
+    for (; i < cnt; ++i) { \
+        lhs[i] += rhs[i]; \
+    } \
+} \
+__attribute__((target(ISA))) inline void sub (T* lhs, const T* rhs, int cnt) { \
+    int i = 0; \
+    for (; i + W <= cnt; i += W) { \
+        STORE(lhs + i, SUB(LOAD(lhs + i), LOAD(rhs + i))); \
+    } \
+    for (; i < cnt; ++i) { \
+        lhs[i] -= rhs[i]; \
+    } \
+} \
+__attribute__((target(ISA))) inline void mul (T* array, T scalar, int cnt) { \
+    V s = SET1(scalar); \
+    int i = 0; \
+    for (; i + W <= cnt; i += W) { \
+        STORE(array + i, MUL(LOAD(array + i), s)); \
+    } \
+    for (; i < cnt; ++i) { \
+        array[i] *= scalar; \
+    } \
+} \
+__attribute__((target(ISA))) inline T dot (const T* lhs, const T* rhs, int cnt) { \
+    V S0 = ZERO(), S1 = ZERO(); \
+    int i = 0; \
+    for (; i + 2 * W <= cnt; i += 2 * W) { \
+        S0 = ADD(S0, MUL(LOAD(lhs + i), LOAD(rhs + i))); \
+        S1 = ADD(S1, MUL(LOAD(lhs + i + W), LOAD(rhs + i + W))); \
+    } \
+    if (i + W <= cnt) { \
+        S0 = ADD(S0, MUL(LOAD(lhs + i), LOAD(rhs + i))); \
+        i += W; \
+    } \
+    T S = SUM(ADD(S0, S1)); \
+    for (; i < cnt; ++i) { \
+        S += lhs[i] * rhs[i]; \
+    } \
+    return S; \
+} \
+__attribute__((target(ISA))) inline T norm (const T* array, int cnt) { \
+    return dot(array, array, cnt); \
+} \
+__attribute__((target(ISA))) inline bool cmp (const T* lhs, const T* rhs, int cnt) { \
+    int i = 0; \
+    for (; i + W <= cnt; i += W) { \
+        if (NEQ(LOAD(lhs + i), LOAD(rhs + i))) { \
+            return false; \
+        } \
+    } \
+    for (; i < cnt; ++i) { \
+        if (lhs[i] != rhs[i]) { \
+            return false; \
+        } \
+    } \
+    return true; \
+} \
+__attribute__((target(ISA))) inline void null (T* dst, int cnt) { \
+    V z = ZERO(); \
+    int i = 0; \
+    for (; i + W <= cnt; i += W) { \
+        STORE(dst + i, z); \
+    } \
+    for (; i < cnt; ++i) { \
+        dst[i] = 0; \
+    } \
+}
+
+namespace sse2 {
+
+__attribute__((target("sse2"))) inline double sum (__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+__attribute__((target("sse2"))) inline float sum (__m128 v) {
+    __m128 h = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 1)));
+}
+
+#define SIMD_NEQ_PD(a, b) _mm_movemask_pd(_mm_cmpneq_pd(a, b))
+#define SIMD_NEQ_PS(a, b) _mm_movemask_ps(_mm_cmpneq_ps(a, b))
+
+SIMD_KERNELS("sse2", double, __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd, _mm_sub_pd, _mm_mul_pd, _mm_set1_pd, _mm_setzero_pd, SIMD_NEQ_PD, sum)
+SIMD_KERNELS("sse2", float, __m128, 4, _mm_loadu_ps, _mm_storeu_ps, _mm_add_ps, _mm_sub_ps, _mm_mul_ps, _mm_set1_ps, _mm_setzero_ps, SIMD_NEQ_PS, sum)
+
+#undef SIMD_NEQ_PD
+#undef SIMD_NEQ_PS
+
+}
+
+namespace avx2 {
+
+__attribute__((target("avx2"))) inline double sum (__m256d v) {
+    return sse2::sum(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+}
+
+__attribute__((target("avx2"))) inline float sum (__m256 v) {
+    return sse2::sum(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+}
+
+#define SIMD_NEQ_PD(a, b) _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_NEQ_UQ))
+#define SIMD_NEQ_PS(a, b) _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ))
+
+SIMD_KERNELS("avx2", double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_set1_pd, _mm256_setzero_pd, SIMD_NEQ_PD, sum)
+SIMD_KERNELS("avx2", float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_set1_ps, _mm256_setzero_ps, SIMD_NEQ_PS, sum)
+
+#undef SIMD_NEQ_PD
+#undef SIMD_NEQ_PS
+
+}
+
+namespace avx512 {
+
+__attribute__((target("avx512f"))) inline double sum (__m512d v) {
+    double t[8];
+    _mm512_storeu_pd(t, v);
+    return ((t[0] + t[4]) + (t[2] + t[6])) + ((t[1] + t[5]) + (t[3] + t[7]));
+}
+
+__attribute__((target("avx512f"))) inline float sum (__m512 v) {
+    float t[16];
+    _mm512_storeu_ps(t, v);
+    return avx2::sum(_mm256_add_ps(_mm256_loadu_ps(t), _mm256_loadu_ps(t + 8)));
+}
+
+#define SIMD_NEQ_PD(a, b) _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ)
+#define SIMD_NEQ_PS(a, b) _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ)
+
+SIMD_KERNELS("avx512f", double, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd, _mm512_set1_pd, _mm512_setzero_pd, SIMD_NEQ_PD, sum)
+SIMD_KERNELS("avx512f", float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps, _mm512_set1_ps, _mm512_setzero_ps, SIMD_NEQ_PS, sum)
+
+#undef SIMD_NEQ_PD
+#undef SIMD_NEQ_PS
+
+}
+
+#undef SIMD_KERNELS
+
+/*
+  Диспетчеризация: выбор ядра по набору инструкций текущего процессора
+*/
+
+#define SIMD_DISPATCH(CALL) \
+    switch (level()) { \
+    case AVX512: \
+        avx512::CALL; \
+        return true; \
+    case AVX2: \
+        avx2::CALL; \
+        return true; \
+    case SSE2: \
+        sse2::CALL; \
+        return true; \
+    default: \
+        return false; \
+    }
+
+#define SIMD_DISPATCH_RESULT(R, CALL) \
+    switch (level()) { \
+    case AVX512: \
+        R = avx512::CALL; \
+        return true; \
+    case AVX2: \
+        R = avx2::CALL; \
+        return true; \
+    case SSE2: \
+        R = sse2::CALL; \
+        return true; \
+    default: \
+        return false; \
+    }
+
+#define SIMD_OVERLOADS(T) \
+inline bool add (T* lhs, const T* rhs, int cnt) { \
+    SIMD_DISPATCH(add(lhs, rhs, cnt)) \
+} \
+inline bool sub (T* lhs, const T* rhs, int cnt) { \
+    SIMD_DISPATCH(sub(lhs, rhs, cnt)) \
+} \
+inline bool mul (T* array, T scalar, int cnt) { \
+    SIMD_DISPATCH(mul(array, scalar, cnt)) \
+} \
+inline bool null (T* dst, int cnt) { \
+    SIMD_DISPATCH(null(dst, cnt)) \
+} \
+inline bool dot (T& S, const T* lhs, const T* rhs, int cnt) { \
+    SIMD_DISPATCH_RESULT(S, dot(lhs, rhs, cnt)) \
+} \
+inline bool norm (T& S, const T* array, int cnt) { \
+    SIMD_DISPATCH_RESULT(S, norm(array, cnt)) \
+} \
+inline bool cmp (bool& equal, const T* lhs, const T* rhs, int cnt) { \
+    SIMD_DISPATCH_RESULT(equal, cmp(lhs, rhs, cnt)) \
+}
+
+SIMD_OVERLOADS(double)
+SIMD_OVERLOADS(float)
+
+#undef SIMD_OVERLOADS
+#undef SIMD_DISPATCH
+#undef SIMD_DISPATCH_RESULT
+
+#endif
+
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef _MATRIX_SOLVE_H
+#define _MATRIX_SOLVE_H
+
+#include <GenericMatrix.h>
+#include <SquareMatrix.h>
+#include <ColumnMatrix.h>
+#include <LU.h>
+#include <Cholesky.h>
+#include <SymmetricMatrix.h>
+
+namespace Matrix {
+
+/*! \relates SquareMatrix
+  решение системы линейных уравнений A x = b прямой и обратной подстановкой по LU-разложению
+  (обратная матрица не вычисляется)
+  \param A - матрица системы
+  \param b - правая часть
+  \return решение системы (нулевая матрица-столбец в случае вырожденности \a A)
+*/
+template<typename T, int n>
+ColumnMatrix<T, n> solve (const SquareMatrix<T, n>& A, const ColumnMatrix<T, n>& b) {
+    return LU<T, n>(A).solve(b);
+}
+
+/*! \relates SquareMatrix
+  решение системы линейных уравнений A X = B с несколькими правыми частями
+  \tparam k - количество правых частей
+  \param A - матрица системы
+  \param B - правые части, матрица \a n x \a k
+  \return решение системы, матрица \a n x \a k (нулевая в случае вырожденности \a A)
+*/
+template<typename T, int n, int k>
+GenericMatrix<T, n, k> solve (const SquareMatrix<T, n>& A, const GenericMatrix<T, n, k>& B) {
+    return LU<T, n>(A).solve(B);
+}
+
+/*! \relates SymmetricMatrix
+  решение системы линейных уравнений A x = b с симметричной матрицей
+  (разложением Холецкого для положительно определенной \a A, иначе LU-разложением)
+  \param A - симметричная матрица системы
+  \param b - правая часть
+  \return решение системы (нулевая матрица-столбец в случае вырожденности \a A)
+*/
+template<typename T, int n>
+ColumnMatrix<T, n> solve (const SymmetricMatrix<T, n>& A, const ColumnMatrix<T, n>& b) {
+    const SquareMatrix<T, n> F = A;
+    Cholesky<T, n> C(F);
+    if (C.positive()) {
+        return C.solve(b);
+    }
+    return LU<T, n>(F).solve(b);
+}
+
+/*! \relates SymmetricMatrix
+  решение системы линейных уравнений A X = B с симметричной матрицей и несколькими правыми частями
+  \tparam k - количество правых частей
+  \param A - симметричная матрица системы
+  \param B - правые части, матрица \a n x \a k
+  \return решение системы, матрица \a n x \a k (нулевая в случае вырожденности \a A)
+*/
+template<typename T, int n, int k>
+GenericMatrix<T, n, k> solve (const SymmetricMatrix<T, n>& A, const GenericMatrix<T, n, k>& B) {
+    const SquareMatrix<T, n> F = A;
+    Cholesky<T, n> C(F);
+    if (C.positive()) {
+        return C.solve(B);
+    }
+    return LU<T, n>(F).solve(B);
+}
+
+}
+
+#endif
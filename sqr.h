@@ -4,7 +4,7 @@
 #include <ColumnMatrix.h>
 #include <RowMatrix.h>
 #include <SquareMatrix.h>
-#include <transpose.h>
+#include <TransposedView.h>
 
 namespace Matrix {
 
@@ -14,8 +14,8 @@ namespace Matrix {
   \return квадратная матрица, равная произведению \a v на транспонированную \a v
 */
 template<typename T, int n>
-const SquareMatrix<T, n> sqr (const ColumnMatrix<T, n>& v) {
-    return v * transpose(v);
+SquareMatrix<T, n> sqr (const ColumnMatrix<T, n>& v) {
+    return v * transposed(v);
 }
 
 /*! \relates RowMatrix
@@ -24,8 +24,8 @@ const SquareMatrix<T, n> sqr (const ColumnMatrix<T, n>& v) {
   \return квадратная матрица, равная произведению транспонированной \a v на \a v
 */
 template<typename T, int n>
-const SquareMatrix<T, n> sqr (const RowMatrix<T, n>& v) {
-    return transpose(v) * v;
+SquareMatrix<T, n> sqr (const RowMatrix<T, n>& v) {
+    return transposed(v) * v;
 }
 
 }
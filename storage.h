@@ -0,0 +1,129 @@
+#ifndef _MATRIX_STORAGE_H
+#define _MATRIX_STORAGE_H
+
+#include <type_traits>
+#include <utility>
+#include "constexpr.h"
+#include "aligned.h"
+
+/*! \def HEAP_STORAGE_THRESHOLD
+  Размер массива элементов матрицы (в байтах), начиная с которого матрица фиксированного размера
+  по умолчанию хранит элементы в куче, а не внутри объекта (на стеке)
+*/
+
+#ifndef HEAP_STORAGE_THRESHOLD
+#define HEAP_STORAGE_THRESHOLD (16 * 1024)
+#endif
+
+namespace Matrix {
+
+/*! \namespace storage
+  Способы хранения элементов матриц фиксированного размера
+*/
+namespace storage {
+
+/*! \class Inline
+  \brief хранение элементов внутри объекта матрицы
+*/
+struct Inline {
+};
+
+/*! \class Heap
+  \brief хранение элементов в выровненном массиве в куче: перемещение матрицы не копирует элементы
+*/
+struct Heap {
+};
+
+/*! \class Default
+  \brief способ хранения по умолчанию: в куче, если массив элементов больше HEAP_STORAGE_THRESHOLD байт
+  \tparam T - тип элементов
+  \tparam size - количество элементов
+*/
+template<typename T, int size>
+struct Default {
+    typedef typename std::conditional<((long long) sizeof(T) * size > HEAP_STORAGE_THRESHOLD), Heap, Inline>::type type;
+};
+
+/*! \class Array
+  \brief массив элементов матрицы с заданным способом хранения
+  \tparam T - тип элементов
+  \tparam size - количество элементов
+  \tparam S - способ хранения (Inline или Heap)
+*/
+template<typename T, int size, typename S>
+class Array;
+
+template<typename T, int size>
+class Array<T, size, Inline> {
+    T m_array[size];
+public:
+    MATRIX_CONSTEXPR Array (void) {
+    }
+
+    MATRIX_CONSTEXPR const T* data (void) const {
+        return m_array;
+    }
+
+    MATRIX_CONSTEXPR T* data (void) {
+        return m_array;
+    }
+};
+
+template<typename T, int size>
+class Array<T, size, Heap> {
+    T* m_array;
+
+/*
+  у перемещенной матрицы массива нет: при чтении она нулевая (общий статический массив),
+  при изменении массив выделяется заново и обнуляется
+*/
+    static const T* empty (void) {
+        alignas(MEMORY_ALIGNMENT) static const T array[size] = {};
+        return array;
+    }
+public:
+    Array (void) : m_array(algorithms::allocate<T>(size)) {
+    }
+
+    Array (const Array& other) : m_array(algorithms::allocate<T>(size)) {
+        algorithms::cp(m_array, other.data(), size);
+    }
+
+    Array (Array&& other) noexcept : m_array(other.m_array) {
+        other.m_array = nullptr;
+    }
+
+    ~Array (void) {
+        algorithms::deallocate(m_array);
+    }
+
+    Array& operator = (const Array& other) {
+        if (this != &other) {
+            algorithms::cp(data(), other.data(), size);
+        }
+        return *this;
+    }
+
+    Array& operator = (Array&& other) noexcept {
+        std::swap(m_array, other.m_array);
+        return *this;
+    }
+
+    const T* data (void) const {
+        return m_array ? m_array : empty();
+    }
+
+    T* data (void) {
+        if (!m_array) {
+            m_array = algorithms::allocate<T>(size);
+            algorithms::null(m_array, size, 1);
+        }
+        return m_array;
+    }
+};
+
+}
+
+}
+
+#endif
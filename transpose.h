@@ -6,6 +6,7 @@
 #include <ColumnMatrix.h>
 #include <RowMatrix.h>
 #include "algorithms.h"
+#include "fixed.h"
 
 namespace Matrix {
 
@@ -16,20 +17,32 @@ namespace Matrix {
   \param M - матрица \a n x \a m
   \return матрица \a m x \a n - транспонированная \a M
 */
-template<typename T, int n, int m>
-const GenericMatrix<T, m, n> transpose (const GenericMatrix<T, n, m>& M) {
+template<typename T, int n, int m, typename S>
+MATRIX_CONSTEXPR GenericMatrix<T, m, n> transpose (const GenericMatrix<T, n, m, S>& M) {
     GenericMatrix<T, m, n> R;
-    algorithms::transpose(R.array(), M.array(), n, m);
+    algorithms::fixed::Transpose<n, m>::run(R.array(), M.array());
     return R;
 }
 
+/*! \relates GenericExpression
+  транспонирование выражения (выражение предварительно вычисляется)
+  \tparam n - количество строк выражения
+  \tparam m - количество столбцов выражения
+  \param expression - выражение \a n x \a m
+  \return матрица \a m x \a n - транспонированное \a expression
+*/
+template<typename E, typename T, int n, int m>
+MATRIX_CONSTEXPR GenericMatrix<T, m, n> transpose (const GenericExpression<E, T, n, m>& expression) {
+    return transpose(GenericMatrix<T, n, m>(expression));
+}
+
 /*! \relates SquareMatrix
   транспонирование квадратной матрицы
   \param M - квадратная матрица
   \return квадратная матрица - транспонированная \a M
 */
 template<typename T, int n>
-const SquareMatrix<T, n> transpose (const SquareMatrix<T, n>& M) {
+MATRIX_CONSTEXPR SquareMatrix<T, n> transpose (const SquareMatrix<T, n>& M) {
     return transpose((const GenericMatrix<T, n, n>&) M);
 }
 
@@ -39,7 +52,7 @@ const SquareMatrix<T, n> transpose (const SquareMatrix<T, n>& M) {
   \return матрица-строка - транспонированная \a M
 */
 template<typename T, int n>
-const RowMatrix<T, n> transpose (const ColumnMatrix<T, n>& M) {
+MATRIX_CONSTEXPR RowMatrix<T, n> transpose (const ColumnMatrix<T, n>& M) {
     return transpose((const GenericMatrix<T, n, 1>&) M);
 }
 
@@ -49,7 +62,7 @@ const RowMatrix<T, n> transpose (const ColumnMatrix<T, n>& M) {
   \return матрица-столбец - транспонированная \a M
 */
 template<typename T, int n>
-const ColumnMatrix<T, n> transpose (const RowMatrix<T, n>& M) {
+MATRIX_CONSTEXPR ColumnMatrix<T, n> transpose (const RowMatrix<T, n>& M) {
     return transpose((const GenericMatrix<T, 1, n>&) M);
 }
 